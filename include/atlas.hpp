@@ -0,0 +1,299 @@
+#pragma once
+#include "rasterizer.hpp"
+
+namespace zketch {
+
+	// skyline bottom-left : permukaan halaman disimpan sebagai deretan segmen horizontal
+	// (x, y, w), rect baru diletakkan di posisi yang puncaknya paling rendah lalu paling kiri.
+	// y ke bawah, jadi "rendah" di sini berarti y + h terkecil.
+	class SkylinePacker {
+	private :
+		struct Node {
+			uint32_t x, y, w ;
+		} ;
+
+		std::vector<Node> nodes_ ;
+		uint32_t width_ = 0 ;
+		uint32_t height_ = 0 ;
+		uint64_t used_ = 0 ;
+
+		// y tempat rect selebar w bisa diletakkan mulai node index, false bila tidak muat
+		bool Fit(size_t index, uint32_t w, uint32_t h, uint32_t& y) const noexcept {
+			uint32_t x = nodes_[index].x ;
+			if (static_cast<uint64_t>(x) + w > width_) {
+				return false ;
+			}
+
+			y = 0 ;
+			uint32_t left = w ;
+			for (size_t i = index; left > 0; ++i) {
+				y = std::max(y, nodes_[i].y) ;
+				if (static_cast<uint64_t>(y) + h > height_) {
+					return false ;
+				}
+				left -= std::min(left, nodes_[i].w) ;
+			}
+			return true ;
+		}
+
+	public :
+		SkylinePacker() = default ;
+
+		SkylinePacker(uint32_t width, uint32_t height) noexcept {
+			Reset(width, height) ;
+		}
+
+		void Reset(uint32_t width, uint32_t height) noexcept {
+			width_ = width ;
+			height_ = height ;
+			used_ = 0 ;
+			nodes_.clear() ;
+			nodes_.push_back({0, 0, width}) ;
+		}
+
+		void Reset() noexcept {
+			Reset(width_, height_) ;
+		}
+
+		bool Insert(uint32_t w, uint32_t h, Rect& out) noexcept {
+			if (w == 0 || h == 0 || w > width_ || h > height_) {
+				return false ;
+			}
+
+			size_t best = nodes_.size() ;
+			uint32_t best_y = 0 ;
+			uint64_t best_top = std::numeric_limits<uint64_t>::max() ;
+			for (size_t i = 0; i < nodes_.size(); ++i) {
+				uint32_t y ;
+				if (Fit(i, w, h, y) && static_cast<uint64_t>(y) + h < best_top) {
+					best = i ;
+					best_y = y ;
+					best_top = static_cast<uint64_t>(y) + h ;
+				}
+			}
+
+			if (best == nodes_.size()) {
+				return false ;
+			}
+
+			Node placed {nodes_[best].x, best_y + h, w} ;
+			nodes_.insert(nodes_.begin() + best, placed) ;
+
+			// potong segmen yang tertutup rect baru
+			uint32_t right = placed.x + placed.w ;
+			for (size_t i = best + 1; i < nodes_.size();) {
+				Node& n = nodes_[i] ;
+				if (n.x >= right) {
+					break ;
+				}
+
+				uint32_t cut = right - n.x ;
+				if (cut >= n.w) {
+					nodes_.erase(nodes_.begin() + i) ;
+					continue ;
+				}
+
+				n.x += cut ;
+				n.w -= cut ;
+				break ;
+			}
+
+			// gabung segmen bersebelahan dengan tinggi sama
+			for (size_t i = 0; i + 1 < nodes_.size();) {
+				if (nodes_[i].y == nodes_[i + 1].y) {
+					nodes_[i].w += nodes_[i + 1].w ;
+					nodes_.erase(nodes_.begin() + i + 1) ;
+					continue ;
+				}
+				++i ;
+			}
+
+			out = Rect(static_cast<int32_t>(placed.x), static_cast<int32_t>(best_y), w, h) ;
+			used_ += static_cast<uint64_t>(w) * h ;
+			return true ;
+		}
+
+		uint64_t GetUsedArea() const noexcept { return used_ ; }
+		float GetOccupancy() const noexcept { return width_ && height_ ? static_cast<float>(used_) / (static_cast<float>(width_) * static_cast<float>(height_)) : 0.0f ; }
+		size_t GetNodeCount() const noexcept { return nodes_.size() ; }
+		uint32_t GetWidth() const noexcept { return width_ ; }
+		uint32_t GetHeight() const noexcept { return height_ ; }
+	} ;
+
+	struct AtlasSlot {
+		static constexpr uint32_t InvalidPage = 0xFFFFFFFF ;
+
+		uint32_t page_ = InvalidPage ;
+		Rect rect_ {} ;
+
+		bool IsValid() const noexcept { return page_ != InvalidPage ; }
+	} ;
+
+	// halaman-halaman pixel besar tempat permukaan widget ditaruh sebagai sub-rect.
+	// slot yang dilepas dipakai ulang untuk ukuran yang sama, dan halaman yang kosong
+	// seluruhnya di-reset. memori halaman tidak pernah dipindah selama atlas hidup.
+	class TextureAtlas {
+	private :
+		struct Page {
+			PixelBuffer pixels_ ;
+			SkylinePacker packer_ ;
+			uint32_t live_ = 0 ;
+		} ;
+
+		std::vector<std::unique_ptr<Page>> pages_ ;
+		std::vector<AtlasSlot> free_ ;
+		Size page_size_ ;
+		uint32_t live_ = 0 ;
+
+		static void ClearRect(PixelBuffer& pixels, const Rect& r) noexcept {
+			for (uint32_t y = 0; y < r.h; ++y) {
+				std::memset(pixels.GetRow(static_cast<uint32_t>(r.y) + y) + r.x, 0, static_cast<size_t>(r.w) * sizeof(uint32_t)) ;
+			}
+		}
+
+		AtlasSlot Place(uint32_t index, const Size& size) noexcept {
+			Page& page = *pages_[index] ;
+			Rect r ;
+			if (!page.packer_.Insert(size.x, size.y, r)) {
+				return {} ;
+			}
+
+			++page.live_ ;
+			++live_ ;
+			return {index, r} ;
+		}
+
+	public :
+		static constexpr uint32_t DefaultPageSize = 1024 ;
+
+		TextureAtlas(const TextureAtlas&) = delete ;
+		TextureAtlas& operator=(const TextureAtlas&) = delete ;
+
+		explicit TextureAtlas(const Size& page_size = {DefaultPageSize, DefaultPageSize}) noexcept :
+		page_size_(std::max(page_size.x, 1u), std::max(page_size.y, 1u)) {}
+
+		// slot berisi pixel transparan. invalid bila size lebih besar dari halaman
+		// atau halaman baru gagal dialokasi, pemanggil sebaiknya memakai canvas biasa.
+		AtlasSlot Allocate(const Size& size) noexcept {
+			if (size.x == 0 || size.y == 0 || size.x > page_size_.x || size.y > page_size_.y) {
+				return {} ;
+			}
+
+			for (size_t i = 0; i < free_.size(); ++i) {
+				if (free_[i].rect_.w == size.x && free_[i].rect_.h == size.y) {
+					AtlasSlot slot = free_[i] ;
+					free_[i] = free_.back() ;
+					free_.pop_back() ;
+
+					ClearRect(pages_[slot.page_]->pixels_, slot.rect_) ;
+					++pages_[slot.page_]->live_ ;
+					++live_ ;
+					return slot ;
+				}
+			}
+
+			for (uint32_t i = 0; i < pages_.size(); ++i) {
+				AtlasSlot slot = Place(i, size) ;
+				if (slot.IsValid()) {
+					ClearRect(pages_[i]->pixels_, slot.rect_) ;
+					return slot ;
+				}
+			}
+
+			auto page = std::make_unique<Page>() ;
+			if (!page->pixels_.Create(page_size_)) {
+
+				#ifdef CANVAS_DEBUG
+					logger::error("TextureAtlas::Allocate - Failed to allocate atlas page.") ;
+				#endif
+
+				return {} ;
+			}
+
+			page->packer_.Reset(page_size_.x, page_size_.y) ;
+			pages_.push_back(std::move(page)) ;
+			return Place(static_cast<uint32_t>(pages_.size() - 1), size) ;
+		}
+
+		void Release(const AtlasSlot& slot) noexcept {
+			if (!slot.IsValid() || slot.page_ >= pages_.size()) {
+				return ;
+			}
+
+			Page& page = *pages_[slot.page_] ;
+			--page.live_ ;
+			--live_ ;
+
+			if (page.live_ == 0) {
+				page.packer_.Reset() ;
+				free_.erase(std::remove_if(free_.begin(), free_.end(), [&](const AtlasSlot& s) {
+					return s.page_ == slot.page_ ;
+				}), free_.end()) ;
+				return ;
+			}
+
+			try {
+				free_.push_back(slot) ;
+			} catch (...) {}
+		}
+
+		uint32_t* GetData(const AtlasSlot& slot) noexcept {
+			return pages_[slot.page_]->pixels_.GetRow(static_cast<uint32_t>(slot.rect_.y)) + slot.rect_.x ;
+		}
+
+		PixelBuffer* GetPage(uint32_t index) noexcept { return index < pages_.size() ? &pages_[index]->pixels_ : nullptr ; }
+		const PixelBuffer* GetPage(uint32_t index) const noexcept { return index < pages_.size() ? &pages_[index]->pixels_ : nullptr ; }
+
+		uint32_t GetStride() const noexcept { return pages_.empty() ? 0 : pages_.front()->pixels_.GetStride() ; }
+		uint32_t GetPageCount() const noexcept { return static_cast<uint32_t>(pages_.size()) ; }
+		uint32_t GetLiveCount() const noexcept { return live_ ; }
+		const Size& GetPageSize() const noexcept { return page_size_ ; }
+
+		float GetOccupancy(uint32_t index) const noexcept {
+			return index < pages_.size() ? pages_[index]->packer_.GetOccupancy() : 0.0f ;
+		}
+	} ;
+
+	// kepemilikan satu slot atlas, dilepas otomatis. dipakai Canvas.
+	class AtlasLease {
+	private :
+		TextureAtlas* atlas_ = nullptr ;
+		AtlasSlot slot_ {} ;
+
+	public :
+		AtlasLease(const AtlasLease&) = delete ;
+		AtlasLease& operator=(const AtlasLease&) = delete ;
+		AtlasLease() = default ;
+
+		AtlasLease(TextureAtlas* atlas, const AtlasSlot& slot) noexcept : atlas_(atlas), slot_(slot) {}
+
+		AtlasLease(AtlasLease&& o) noexcept :
+		atlas_(std::exchange(o.atlas_, nullptr)),
+		slot_(std::exchange(o.slot_, AtlasSlot{})) {}
+
+		AtlasLease& operator=(AtlasLease&& o) noexcept {
+			if (this != &o) {
+				Reset() ;
+				atlas_ = std::exchange(o.atlas_, nullptr) ;
+				slot_ = std::exchange(o.slot_, AtlasSlot{}) ;
+			}
+			return *this ;
+		}
+
+		~AtlasLease() noexcept {
+			Reset() ;
+		}
+
+		void Reset() noexcept {
+			if (atlas_) {
+				atlas_->Release(slot_) ;
+			}
+			atlas_ = nullptr ;
+			slot_ = {} ;
+		}
+
+		bool IsValid() const noexcept { return atlas_ != nullptr ; }
+		TextureAtlas* GetAtlas() const noexcept { return atlas_ ; }
+		const AtlasSlot& GetSlot() const noexcept { return slot_ ; }
+	} ;
+}
\ No newline at end of file
@@ -12,6 +12,7 @@ namespace zketch {
         Font font_ ;
         std::function<void(Canvas*, const Button&)> drawing_logic_ ;
         std::function<void()> callback_ ;
+		mutable ChromeCache<3> chrome_ ;
 
 		void UpdateImpl() noexcept {
             if (!drawing_logic_) {
@@ -29,7 +30,7 @@ namespace zketch {
         Button(const RectF& bound, const Font& font, const std::wstring& label = L"") noexcept : label_(label), font_(font) {
             bound_ = bound ;
             canvas_ = std::make_unique<Canvas>() ;
-            canvas_->Create(bound_.GetSize()) ;
+            CreateSurface(*canvas_, bound_.GetSize()) ;
 
             SetDrawingLogic([](Canvas* canvas, const Button& button) {
                 Renderer render ;
@@ -38,23 +39,7 @@ namespace zketch {
 				}
 
 				render.Clear(Transparent) ;
-                Color button_color ;
-                Color border_color ;
-                
-                if (button.IsPressed()) {
-                    button_color = rgba(70, 130, 180, 1) ;
-                    border_color = rgba(50, 100, 150, 1) ;
-                } else if (button.IsHovered()) {
-                    button_color = rgba(100, 149, 237, 1) ;
-                    border_color = rgba(70, 119, 207, 1) ;
-                } else {
-                    button_color = rgba(135, 206, 250, 1) ;
-                    border_color = rgba(100, 171, 220, 1) ;
-                }
-                
-                RectF rect = button.GetRelativeBound() ;
-                render.FillRectRounded(rect, button_color, 5.0f) ;
-                render.DrawRectRounded(rect, border_color, 5.0f, 2.0f) ;
+                render.DrawCanvas(button.GetChrome(), {0, 0}) ;
                 
                 if (!button.GetLabel().empty()) {
                     Color text_color = rgba(255, 255, 255, 1) ;
@@ -73,7 +58,7 @@ namespace zketch {
             bool state = bound_.Contain(mouse_pos) ;
             if (state != is_hovered_) {
                 is_hovered_ = state ;
-                update_ = true ;
+                MarkDirty() ;
             }
             return state ;
         }
@@ -81,7 +66,7 @@ namespace zketch {
         bool OnPress(const PointF& mouse_pos) noexcept {
             if (bound_.Contain(mouse_pos)) {
                 is_pressed_ = true ;
-                update_ = true ;
+                MarkDirty() ;
                 return true ;
             }
             return false ;
@@ -91,7 +76,7 @@ namespace zketch {
             bool was_pressed = is_pressed_ ;
             is_pressed_ = false ;
             if (was_pressed) {
-                update_ = true ;
+                MarkDirty() ;
                 if (bound_.Contain(mouse_pos) && callback_) {
                     callback_() ;
                 }
@@ -102,7 +87,7 @@ namespace zketch {
 
         void SetDrawingLogic(std::function<void(Canvas*, const Button&)> drawing_logic) noexcept {
             drawing_logic_ = std::move(drawing_logic) ;
-            update_ = true ;
+            MarkDirty() ;
         }
         
         void SetCallback(std::function<void()> callback) noexcept {
@@ -112,13 +97,13 @@ namespace zketch {
         void SetLabel(const std::wstring& label) noexcept {
             if (label_ != label) {
                 label_ = label ;
-                update_ = true ;
+                MarkDirty() ;
             }
         }
 
 		void SetFont(const Font& font) noexcept { 
 			font_ = font ; 
-			update_ = true ;
+			MarkDirty() ;
 		}
 
         RectF GetRelativeBound() const noexcept { return {0, 0, bound_.w, bound_.h} ; }
@@ -126,6 +111,36 @@ namespace zketch {
         const Font& GetFont() const noexcept { return font_ ; }
 		const Font* GetFontPtr() const noexcept { return &font_ ; }
 
+		// background + border default per state (normal, hover, press). tiap state direkam
+		// dan dirasterisasi sekali per ukuran, pergantian state hanya memilih canvas lain.
+		const Canvas* GetChrome() const noexcept {
+			size_t state = is_pressed_ ? 2 : (is_hovered_ ? 1 : 0) ;
+			Size size = GetRelativeBound().GetSize() ;
+			uint64_t key = DisplayList::MakeKey(bound_.w, bound_.h) ;
+
+			return chrome_.Get(state, key, size, [state, this](Renderer& recorder) {
+				Color button_color ;
+				Color border_color ;
+
+				if (state == 2) {
+					button_color = rgba(70, 130, 180, 1) ;
+					border_color = rgba(50, 100, 150, 1) ;
+				} else if (state == 1) {
+					button_color = rgba(100, 149, 237, 1) ;
+					border_color = rgba(70, 119, 207, 1) ;
+				} else {
+					button_color = rgba(135, 206, 250, 1) ;
+					border_color = rgba(100, 171, 220, 1) ;
+				}
+
+				RectF rect = GetRelativeBound() ;
+				recorder.FillRectRounded(rect, button_color, 5.0f) ;
+				recorder.DrawRectRounded(rect, border_color, 5.0f, 2.0f) ;
+			}) ;
+		}
+
+		const ChromeCache<3>& GetChromeCache() const noexcept { return chrome_ ; }
+
         bool IsHovered() const noexcept { return is_hovered_ ; }
         bool IsPressed() const noexcept { return is_pressed_ ; }
     } ;
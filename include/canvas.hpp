@@ -1,15 +1,212 @@
 #pragma once
 #include "font.hpp"
+#include "atlas.hpp"
+#include "region.hpp"
 
 namespace zketch {
 
+	// ZKETCH_SOFTWARE_RENDERER memaksa semua canvas memakai rasterizer software
+	#if defined (ZKETCH_WIN32) && !defined (ZKETCH_SOFTWARE_RENDERER)
+		inline constexpr CanvasBackend DefaultCanvasBackend = CanvasBackend::GdiPlus ;
+	#else
+		inline constexpr CanvasBackend DefaultCanvasBackend = CanvasBackend::Software ;
+	#endif
+
+	// akses langsung ke pixel canvas (ARGB premultiplied) selama object ini hidup.
+	// backend software memakai memori canvas apa adanya, backend GDI+ lewat LockBits.
+	// akses Write menandai area sebagai damage saat Unlock. jangan menggambar ke
+	// canvas lewat Renderer selama masih terkunci.
+	class PixelSpan {
+		friend class Canvas ;
+
+	private :
+		uint32_t* data_ = nullptr ;
+		ptrdiff_t stride_ = 0 ; // dalam pixel
+		Rect area_ {} ;
+		PixelAccess access_ = PixelAccess::Read ;
+		DamageRegion* damage_ = nullptr ;
+	#ifdef ZKETCH_WIN32
+		Gdiplus::Bitmap* bitmap_ = nullptr ;
+		Gdiplus::BitmapData locked_ {} ;
+	#endif
+
+	public :
+		PixelSpan(const PixelSpan&) = delete ;
+		PixelSpan& operator=(const PixelSpan&) = delete ;
+		PixelSpan() = default ;
+
+		PixelSpan(PixelSpan&& o) noexcept :
+		data_(std::exchange(o.data_, nullptr)),
+		stride_(std::exchange(o.stride_, 0)),
+		area_(o.area_),
+		access_(o.access_),
+		damage_(std::exchange(o.damage_, nullptr))
+	#ifdef ZKETCH_WIN32
+		, bitmap_(std::exchange(o.bitmap_, nullptr)),
+		locked_(o.locked_)
+	#endif
+		{}
+
+		PixelSpan& operator=(PixelSpan&& o) noexcept {
+			if (this != &o) {
+				Unlock() ;
+				data_ = std::exchange(o.data_, nullptr) ;
+				stride_ = std::exchange(o.stride_, 0) ;
+				area_ = o.area_ ;
+				access_ = o.access_ ;
+				damage_ = std::exchange(o.damage_, nullptr) ;
+				#ifdef ZKETCH_WIN32
+					bitmap_ = std::exchange(o.bitmap_, nullptr) ;
+					locked_ = o.locked_ ;
+				#endif
+			}
+			return *this ;
+		}
+
+		~PixelSpan() noexcept {
+			Unlock() ;
+		}
+
+		void Unlock() noexcept {
+			if (!data_) {
+				return ;
+			}
+
+			#ifdef ZKETCH_WIN32
+				if (bitmap_) {
+					bitmap_->UnlockBits(&locked_) ;
+					bitmap_ = nullptr ;
+				}
+			#endif
+
+			if (damage_ && IsWritable()) {
+				damage_->Add(area_) ;
+			}
+
+			data_ = nullptr ;
+			damage_ = nullptr ;
+		}
+
+		// y relatif ke area yang dikunci
+		uint32_t* GetRow(uint32_t y) noexcept { return data_ + static_cast<ptrdiff_t>(y) * stride_ ; }
+		const uint32_t* GetRow(uint32_t y) const noexcept { return data_ + static_cast<ptrdiff_t>(y) * stride_ ; }
+
+		uint32_t& At(uint32_t x, uint32_t y) noexcept { return GetRow(y)[x] ; }
+		uint32_t At(uint32_t x, uint32_t y) const noexcept { return GetRow(y)[x] ; }
+
+		bool IsValid() const noexcept { return data_ != nullptr ; }
+		bool IsReadable() const noexcept { return (static_cast<uint8_t>(access_) & static_cast<uint8_t>(PixelAccess::Read)) != 0 ; }
+		bool IsWritable() const noexcept { return (static_cast<uint8_t>(access_) & static_cast<uint8_t>(PixelAccess::Write)) != 0 ; }
+
+		uint32_t* GetData() noexcept { return data_ ; }
+		const uint32_t* GetData() const noexcept { return data_ ; }
+		ptrdiff_t GetStride() const noexcept { return stride_ ; }
+		uint32_t GetWidth() const noexcept { return area_.w ; }
+		uint32_t GetHeight() const noexcept { return area_.h ; }
+		const Rect& GetArea() const noexcept { return area_ ; }
+		PixelAccess GetAccess() const noexcept { return access_ ; }
+	} ;
+
 	class Canvas {
 		friend class Renderer ;
 		friend class Window ;
 
 	private :
+		AtlasLease lease_ {} ; // slot atlas tempat pixels_ dipinjam, dilepas paling akhir
+		PixelBuffer pixels_ {} ;
+	#ifdef ZKETCH_WIN32
+		// untuk backend software, bitmap ini hanya membungkus memori pixels_
 		std::unique_ptr<Gdiplus::Bitmap> canvas_ {} ;
-		bool invalidate_ = false ;
+	#endif
+		CanvasBackend backend_ = DefaultCanvasBackend ;
+		DamageRegion damage_ {} ;
+		Size size_ {} ; // ukuran logis, storage boleh lebih besar (lihat Resize)
+		Rect opaque_ {} ; // area yang pasti berisi pixel alpha 255
+
+		// bungkus ulang memori pixels_ setelah ukuran / stride berubah
+		bool WrapPixels() noexcept {
+			#ifdef ZKETCH_WIN32
+				canvas_.reset() ;
+				try {
+					canvas_ = std::make_unique<Gdiplus::Bitmap>(
+						static_cast<INT>(pixels_.GetWidth()), 
+						static_cast<INT>(pixels_.GetHeight()), 
+						static_cast<INT>(pixels_.GetStride() * sizeof(uint32_t)), 
+						PixelFormat32bppPARGB, 
+						reinterpret_cast<BYTE*>(pixels_.GetData())
+					) ;
+				} catch (...) {
+					canvas_.reset() ;
+				}
+
+				if (!canvas_ || canvas_->GetLastStatus() != Gdiplus::Ok) {
+
+					#ifdef CANVAS_DEBUG
+						logger::error("Canvas::Create - Failed to wrap pixel buffer into bitmap.") ;
+					#endif
+
+					canvas_.reset() ;
+					return false ;
+				}
+			#endif
+
+			return true ;
+		}
+
+		bool CreateSoftware(const Size& size) noexcept {
+			if (!pixels_.Create(size)) {
+
+				#ifdef CANVAS_DEBUG
+					logger::error("Canvas::Create - Failed to allocate pixel buffer.") ;
+				#endif
+
+				return false ;
+			}
+
+			if (!WrapPixels()) {
+				pixels_.Reset() ;
+				return false ;
+			}
+
+			size_ = size ;
+			opaque_ = {} ;
+			MarkInvalidate() ;
+			return true ;
+		}
+
+		// storage saat ini cukup untuk size tanpa alokasi
+		bool Fits(const Size& size) const noexcept {
+			if (IsSoftware()) {
+				constexpr uint32_t px_per_align = PixelBuffer::Alignment / sizeof(uint32_t) ;
+				uint64_t stride = (static_cast<uint64_t>(size.x) + px_per_align - 1) / px_per_align * px_per_align ;
+				return stride * size.y * sizeof(uint32_t) <= pixels_.GetCapacity() ;
+			}
+
+			#ifdef ZKETCH_WIN32
+				return size.x <= canvas_->GetWidth() && size.y <= canvas_->GetHeight() ;
+			#else
+				return false ;
+			#endif
+		}
+
+		bool Reshape(const Size& size) noexcept {
+			if (IsSoftware()) {
+				if (!pixels_.Reshape(size) || !WrapPixels()) {
+					return false ;
+				}
+			} else {
+			#ifdef ZKETCH_WIN32
+				Gdiplus::Graphics gfx(canvas_.get()) ;
+				gfx.Clear(Transparent) ;
+			#endif
+			}
+
+			size_ = size ;
+			opaque_ = {} ;
+			damage_.Clear() ;
+			MarkInvalidate() ;
+			return true ;
+		}
 
 	public :
 		Canvas(const Canvas&) = delete ;
@@ -19,9 +216,25 @@ namespace zketch {
 		Canvas() = default ;
 		~Canvas() = default ;
 
-		bool Create(const Size& size) noexcept {
+		bool Create(const Size& size, CanvasBackend backend = DefaultCanvasBackend) noexcept {
 			Clear() ;
 
+			#ifndef ZKETCH_WIN32
+				backend = CanvasBackend::Software ;
+			#endif
+
+			backend_ = backend ;
+
+			if (backend_ == CanvasBackend::Software) {
+
+				#ifdef CANVAS_DEBUG
+					logger::info("Canvas::Create - Creating software pixel buffer: ", size.x, " x ", size.y, '.') ;
+				#endif
+
+				return CreateSoftware(size) ;
+			}
+
+		#ifdef ZKETCH_WIN32
 			#ifdef CANVAS_DEBUG
 				logger::info("Canvas::Create - Creating GDI+ bitmap: ", size.x, " x ", size.y, '.') ;
 			#endif
@@ -68,27 +281,319 @@ namespace zketch {
 				gfx_front.Clear(Transparent) ;
 			}
 
-			invalidate_ = true ;
+			size_ = size ;
+			opaque_ = {} ;
+			MarkInvalidate() ;
+			return true ;
+		#else
+			return false ;
+		#endif
+		}
+
+		// canvas software yang pixel-nya berada di sub-rect halaman atlas. bila size tidak
+		// muat di halaman atlas, jatuh ke canvas software biasa.
+		bool Create(const Size& size, TextureAtlas& atlas) noexcept {
+			Clear() ;
+			backend_ = CanvasBackend::Software ;
+
+			AtlasSlot slot = atlas.Allocate(size) ;
+			if (!slot.IsValid()) {
+				return CreateSoftware(size) ;
+			}
+
+			lease_ = AtlasLease(&atlas, slot) ;
+			if (!pixels_.Borrow(atlas.GetData(slot), size, atlas.GetStride()) || !WrapPixels()) {
+				pixels_.Reset() ;
+				lease_.Reset() ;
+				return false ;
+			}
+
+			size_ = size ;
+			opaque_ = {} ;
+			MarkInvalidate() ;
 			return true ;
 		}
 
 		void Clear() noexcept {
-			canvas_.reset() ;
-			invalidate_ = false ;
+			#ifdef ZKETCH_WIN32
+				canvas_.reset() ;
+			#endif
+
+			pixels_.Reset() ;
+			lease_.Reset() ;
+			damage_.Clear() ;
+			size_ = {} ;
+			opaque_ = {} ;
 
 			#ifdef CANVAS_DEBUG
 				logger::info("Canvas::Clear - Canvas cleared.") ;
 			#endif
 		}
 
-		bool IsValid() const noexcept { return canvas_ != nullptr ; }
-		bool Invalidate() const noexcept { return invalidate_ ; }
-		void MarkInvalidate() noexcept { invalidate_ = true ; }
-		void MarkValidate() noexcept { invalidate_ = false ; }
+		bool IsValid() const noexcept { 
+			#ifdef ZKETCH_WIN32
+				return canvas_ != nullptr ; 
+			#else
+				return pixels_.IsValid() ;
+			#endif
+		}
+
+		// ubah ukuran logis. storage lama dipakai bila masih cukup (mis. window mengecil),
+		// selain itu dialokasi ulang sebesar max(size, reserve) supaya resize berikutnya
+		// muat. isi canvas tidak dipertahankan dan seluruh permukaan ditandai damage.
+		bool Resize(const Size& size, const Size& reserve = {}) noexcept {
+			if (size.x == 0 || size.y == 0) {
+				return false ;
+			}
+
+			if (IsValid() && size == size_) {
+				return true ;
+			}
+
+			if (IsAtlased()) {
+				return Create(size, *lease_.GetAtlas()) ;
+			}
+
+			if (IsValid() && Fits(size)) {
+				return Reshape(size) ;
+			}
+
+			Size storage {std::max(size.x, reserve.x), std::max(size.y, reserve.y)} ;
+			if (!Create(storage, backend_)) {
+				return false ;
+			}
+
+			return storage == size || Reshape(size) ;
+		}
+
+		// alokasi ulang persis ukuran logis bila storage lebih besar dari size class-nya.
+		// berbeda dengan Resize, isi dan damage canvas dipertahankan.
+		bool Fit() noexcept {
+			if (!IsValid()) {
+				return false ;
+			}
+
+			Canvas fitted ;
+			if (IsSoftware()) {
+				if (IsAtlased() || SurfacePool::ClassOf(pixels_.GetByteSize()) == SurfacePool::ClassOf(pixels_.GetCapacity())) {
+					return true ;
+				}
+
+				if (!fitted.Create(size_, backend_)) {
+					return false ;
+				}
+
+				for (uint32_t y = 0; y < size_.y; ++y) {
+					span_ops::copy_row(fitted.pixels_.GetRow(y), pixels_.GetRow(y), size_.x) ;
+				}
+			} else {
+			#ifdef ZKETCH_WIN32
+				if (canvas_->GetWidth() == size_.x && canvas_->GetHeight() == size_.y) {
+					return true ;
+				}
+
+				if (!fitted.Create(size_, backend_)) {
+					return false ;
+				}
+
+				Gdiplus::Graphics gfx(fitted.canvas_.get()) ;
+				gfx.SetCompositingMode(Gdiplus::CompositingModeSourceCopy) ;
+				gfx.DrawImage(canvas_.get(), 0, 0, 0, 0, static_cast<INT>(size_.x), static_cast<INT>(size_.y), Gdiplus::UnitPixel) ;
+			#else
+				return false ;
+			#endif
+			}
+
+			fitted.damage_ = std::move(damage_) ;
+			fitted.opaque_ = opaque_ ;
+			*this = std::move(fitted) ;
+			return true ;
+		}
+
+		bool IsSoftware() const noexcept { return backend_ == CanvasBackend::Software ; }
+		bool IsAtlased() const noexcept { return lease_.IsValid() ; }
+		bool Invalidate() const noexcept { return !damage_.IsEmpty() ; }
+
+		// seluruh permukaan
+		void MarkInvalidate() noexcept {
+			if (IsValid()) {
+				damage_.Add(Rect{0, 0, GetWidth(), GetHeight()}) ;
+			}
+		}
+
+		// hanya bagian yang berada di dalam canvas yang dicatat
+		void MarkInvalidate(const Rect& area) noexcept {
+			if (IsValid()) {
+				damage_.Add(area, Rect{0, 0, GetWidth(), GetHeight()}) ;
+			}
+		}
+
+		void MarkValidate() noexcept { damage_.Clear() ; }
+
+		// area berisi pixel alpha 255, dicatat Renderer dari Clear dan FillRect yang opaque.
+		// source-over tidak pernah menurunkan alpha, jadi hanya Clear transparan, Lock
+		// dengan akses Write dan salinan ResolveRetain yang mengecilkannya. yang disimpan
+		// hanya satu rect, gabungan dua rect yang tidak membentuk rect memakai yang terluas.
+		void MarkOpaque(const Rect& area) noexcept {
+			Rect r = IntersectRect(area, Rect{0, 0, GetWidth(), GetHeight()}) ;
+			if (r.w == 0) {
+				return ;
+			}
+
+			if (ContainsRect(r, opaque_)) {
+				opaque_ = r ;
+				return ;
+			}
+
+			if (ContainsRect(opaque_, r)) {
+				return ;
+			}
+
+			int64_t r_x1 = static_cast<int64_t>(r.x) + r.w, r_y1 = static_cast<int64_t>(r.y) + r.h ;
+			int64_t o_x1 = static_cast<int64_t>(opaque_.x) + opaque_.w, o_y1 = static_cast<int64_t>(opaque_.y) + opaque_.h ;
+			if (r.x == opaque_.x && r.w == opaque_.w && r.y <= o_y1 && opaque_.y <= r_y1) {
+				int32_t y0 = std::min(r.y, opaque_.y) ;
+				opaque_ = Rect(r.x, y0, r.w, static_cast<uint32_t>(std::max(r_y1, o_y1) - y0)) ;
+				return ;
+			}
+
+			if (r.y == opaque_.y && r.h == opaque_.h && r.x <= o_x1 && opaque_.x <= r_x1) {
+				int32_t x0 = std::min(r.x, opaque_.x) ;
+				opaque_ = Rect(x0, r.y, static_cast<uint32_t>(std::max(r_x1, o_x1) - x0), r.h) ;
+				return ;
+			}
+
+			if (static_cast<uint64_t>(r.w) * r.h > static_cast<uint64_t>(opaque_.w) * opaque_.h) {
+				opaque_ = r ;
+			}
+		}
+
+		// area mungkin tidak lagi opaque, sisakan potongan opaque_ terluas di luar area
+		void ClearOpaque(const Rect& area) noexcept {
+			Rect hit = IntersectRect(area, opaque_) ;
+			if (hit.w == 0) {
+				return ;
+			}
+
+			int32_t o_x1 = opaque_.x + static_cast<int32_t>(opaque_.w) ;
+			int32_t o_y1 = opaque_.y + static_cast<int32_t>(opaque_.h) ;
+			int32_t h_x1 = hit.x + static_cast<int32_t>(hit.w) ;
+			int32_t h_y1 = hit.y + static_cast<int32_t>(hit.h) ;
+			Rect pieces[4] = {
+				Rect(opaque_.x, opaque_.y, opaque_.w, static_cast<uint32_t>(hit.y - opaque_.y)),
+				Rect(opaque_.x, h_y1, opaque_.w, static_cast<uint32_t>(o_y1 - h_y1)),
+				Rect(opaque_.x, opaque_.y, static_cast<uint32_t>(hit.x - opaque_.x), opaque_.h),
+				Rect(h_x1, opaque_.y, static_cast<uint32_t>(o_x1 - h_x1), opaque_.h),
+			} ;
+
+			Rect best {} ;
+			for (const auto& p : pieces) {
+				if (static_cast<uint64_t>(p.w) * p.h > static_cast<uint64_t>(best.w) * best.h) {
+					best = p ;
+				}
+			}
+			opaque_ = best ;
+		}
+
+		void ClearOpaque() noexcept { opaque_ = {} ; }
+
+		bool IsOpaque() const noexcept { return IsValid() && opaque_.w == GetWidth() && opaque_.h == GetHeight() ; }
+		const Rect& GetOpaqueRect() const noexcept { return opaque_ ; }
+
+		// area di-clip ke canvas, span tidak valid bila hasilnya kosong atau lock gagal.
+		// Write tanpa Read : isi awal span tidak terdefinisi untuk backend GDI+.
+		PixelSpan Lock(const Rect& area, PixelAccess access = PixelAccess::ReadWrite) noexcept {
+			PixelSpan span ;
+			if (!IsValid()) {
+				return span ;
+			}
+
+			int64_t x0 = std::max<int64_t>(area.x, 0) ;
+			int64_t y0 = std::max<int64_t>(area.y, 0) ;
+			int64_t x1 = std::min<int64_t>(static_cast<int64_t>(area.x) + area.w, GetWidth()) ;
+			int64_t y1 = std::min<int64_t>(static_cast<int64_t>(area.y) + area.h, GetHeight()) ;
+			if (x1 <= x0 || y1 <= y0) {
+				return span ;
+			}
+
+			Rect clipped(static_cast<int32_t>(x0), static_cast<int32_t>(y0), static_cast<uint32_t>(x1 - x0), static_cast<uint32_t>(y1 - y0)) ;
+			if (access != PixelAccess::Read) {
+				ClearOpaque(clipped) ;
+			}
+
+			if (IsSoftware()) {
+				span.data_ = pixels_.GetRow(clipped.y) + clipped.x ;
+				span.stride_ = pixels_.GetStride() ;
+			} else {
+			#ifdef ZKETCH_WIN32
+				UINT mode = 0 ;
+				if (access != PixelAccess::Write) {
+					mode |= Gdiplus::ImageLockModeRead ;
+				}
+				if (access != PixelAccess::Read) {
+					mode |= Gdiplus::ImageLockModeWrite ;
+				}
+
+				Gdiplus::Rect lock(clipped.x, clipped.y, static_cast<INT>(clipped.w), static_cast<INT>(clipped.h)) ;
+				Gdiplus::Status status = canvas_->LockBits(&lock, mode, PixelFormat32bppPARGB, &span.locked_) ;
+				if (status != Gdiplus::Ok) {
+
+					#ifdef CANVAS_DEBUG
+						logger::error("Canvas::Lock - LockBits failed, status: ", static_cast<int32_t>(status)) ;
+					#endif
+
+					return span ;
+				}
+
+				span.bitmap_ = canvas_.get() ;
+				span.data_ = static_cast<uint32_t*>(span.locked_.Scan0) ;
+				span.stride_ = span.locked_.Stride / static_cast<INT>(sizeof(uint32_t)) ;
+			#else
+				return span ;
+			#endif
+			}
+
+			span.area_ = clipped ;
+			span.access_ = access ;
+			span.damage_ = &damage_ ;
+			return span ;
+		}
+
+		PixelSpan Lock(PixelAccess access = PixelAccess::ReadWrite) noexcept {
+			return Lock(Rect{0, 0, GetWidth(), GetHeight()}, access) ;
+		}
 
+		const DamageRegion& GetDamage() const noexcept { return damage_ ; }
+		void SetDamageCapacity(size_t capacity) noexcept { damage_.SetCapacity(capacity) ; }
+
+	#ifdef ZKETCH_WIN32
 		Gdiplus::Bitmap* GetBitmap() const noexcept { return canvas_.get() ; }
-		uint32_t GetWidth() const noexcept { return canvas_->GetWidth() ; }
-		uint32_t GetHeight() const noexcept { return canvas_->GetHeight() ; }
-		Size GetSize() const noexcept { return {GetWidth(), GetHeight()} ; }
+	#endif
+
+		// nullptr bila canvas bukan backend software
+		PixelBuffer* GetPixels() noexcept { return IsSoftware() && pixels_.IsValid() ? &pixels_ : nullptr ; }
+		const PixelBuffer* GetPixels() const noexcept { return IsSoftware() && pixels_.IsValid() ? &pixels_ : nullptr ; }
+
+		CanvasBackend GetBackend() const noexcept { return backend_ ; }
+
+		// slot invalid bila canvas tidak berada di atlas
+		const AtlasSlot& GetAtlasSlot() const noexcept { return lease_.GetSlot() ; }
+
+		uint32_t GetWidth() const noexcept { return size_.x ; }
+		uint32_t GetHeight() const noexcept { return size_.y ; }
+		Size GetSize() const noexcept { return size_ ; }
+
+		// byte storage yang sedang dipegang, bisa lebih besar dari ukuran logis
+		size_t GetStorageBytes() const noexcept {
+			if (IsSoftware()) {
+				return pixels_.IsBorrowed() ? pixels_.GetByteSize() : pixels_.GetCapacity() ;
+			}
+
+			#ifdef ZKETCH_WIN32
+				return canvas_ ? static_cast<size_t>(canvas_->GetWidth()) * canvas_->GetHeight() * sizeof(uint32_t) : 0 ;
+			#else
+				return 0 ;
+			#endif
+		}
 	} ;
 }
\ No newline at end of file
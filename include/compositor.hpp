@@ -0,0 +1,365 @@
+#pragma once
+#include "present.hpp"
+
+namespace zketch {
+
+	using LayerId = uint32_t ;
+	inline constexpr LayerId InvalidLayer = 0 ;
+
+	struct CompositeStats {
+		uint64_t pixels_composed_ = 0 ;
+		uint32_t rect_count_ = 0 ;
+		uint32_t blits_ = 0 ; // pasangan layer x rect yang digambar
+		uint64_t pixels_copied_ = 0 ;  // source opaque, disalin tanpa blending
+		uint64_t pixels_blended_ = 0 ;
+		uint64_t pixels_skipped_ = 0 ; // tertutup layer opaque di atasnya
+	} ;
+
+	// menyusun canvas-canvas (layer, bawah ke atas) ke satu output yang dipertahankan
+	// antar frame. Compose() hanya menyusun ulang area layar yang disentuh layer yang
+	// berubah : damage canvas layer, posisi, opacity, visibilitas dan urutan. area lain
+	// tetap berisi hasil frame sebelumnya. damage canvas layer dikosongkan setelahnya.
+	// bagian layer yang tertutup area opaque layer di atasnya (Canvas::GetOpaqueRect)
+	// tidak disusun, dan area opaque source disalin tanpa blending.
+	// canvas layer tidak dimiliki, harus hidup selama masih terdaftar.
+	class Compositor {
+	private :
+		struct Layer {
+			LayerId id_ ;
+			Canvas* canvas_ ;
+			Point pos_ ;
+			uint8_t opacity_ ;
+			bool visible_ ;
+			bool changed_ ;
+			Rect last_ ; // area layar saat terakhir disusun, kosong bila tidak tampil
+		} ;
+
+		std::vector<Layer> layers_ ;
+		std::vector<Rect> present_rects_ ;
+		Canvas output_ ;
+		DamageRegion damage_ {} ;  // area yang disusun pada Compose() terakhir
+		DamageRegion pending_ {} ; // area layer yang dihapus / Invalidate() sejak Compose() terakhir
+		CompositeStats stats_ {} ;
+		uint32_t background_ = 0 ;
+		LayerId next_id_ = 1 ;
+		bool full_ = true ;
+
+		static Rect ScreenBound(const Layer& layer) noexcept {
+			if (!layer.visible_ || layer.opacity_ == 0 || !layer.canvas_ || !layer.canvas_->IsValid()) {
+				return {} ;
+			}
+			return Rect(layer.pos_, layer.canvas_->GetSize()) ;
+		}
+
+		// area layar layer yang pasti menutup semua di bawahnya
+		static Rect OpaqueBound(const Layer& layer) noexcept {
+			if (layer.opacity_ != 255) {
+				return {} ;
+			}
+
+			Rect bound = ScreenBound(layer) ;
+			if (bound.w == 0) {
+				return {} ;
+			}
+
+			const Rect& o = layer.canvas_->GetOpaqueRect() ;
+			return Rect(o.x + layer.pos_.x, o.y + layer.pos_.y, o.w, o.h) ;
+		}
+
+		static uint64_t Area(const Rect& r) noexcept {
+			return static_cast<uint64_t>(r.w) * r.h ;
+		}
+
+		// buang bagian r yang tertutup occluder, selama sisanya masih satu rect
+		Rect Occlude(const Rect& r, const Rect& occluder) noexcept {
+			Rect hit = IntersectRect(r, occluder) ;
+			if (hit.w == 0) {
+				return r ;
+			}
+
+			if (ContainsRect(occluder, r)) {
+				stats_.pixels_skipped_ += Area(r) ;
+				return {} ;
+			}
+
+			Rect rest = r ;
+			if (hit.x == r.x && hit.w == r.w) {
+				if (hit.y == r.y) {
+					rest = Rect(r.x, hit.y + static_cast<int32_t>(hit.h), r.w, r.h - hit.h) ;
+				} else if (hit.y + static_cast<int32_t>(hit.h) == r.y + static_cast<int32_t>(r.h)) {
+					rest = Rect(r.x, r.y, r.w, r.h - hit.h) ;
+				}
+			} else if (hit.y == r.y && hit.h == r.h) {
+				if (hit.x == r.x) {
+					rest = Rect(hit.x + static_cast<int32_t>(hit.w), r.y, r.w - hit.w, r.h) ;
+				} else if (hit.x + static_cast<int32_t>(hit.w) == r.x + static_cast<int32_t>(r.w)) {
+					rest = Rect(r.x, r.y, r.w - hit.w, r.h) ;
+				}
+			}
+
+			stats_.pixels_skipped_ += Area(r) - Area(rest) ;
+			return rest ;
+		}
+
+		Layer* Find(LayerId id) noexcept {
+			for (auto& layer : layers_) {
+				if (layer.id_ == id) {
+					return &layer ;
+				}
+			}
+			return nullptr ;
+		}
+
+		void CollectDamage(const Rect& screen) noexcept {
+			if (full_) {
+				damage_.Add(screen) ;
+				return ;
+			}
+
+			for (const auto& r : pending_.GetRects()) {
+				damage_.Add(r, screen) ;
+			}
+
+			for (const auto& layer : layers_) {
+				Rect now = ScreenBound(layer) ;
+				if (layer.changed_ || !(now == layer.last_)) {
+					damage_.Add(layer.last_, screen) ;
+					damage_.Add(now, screen) ;
+					continue ;
+				}
+
+				if (now.w == 0 || !layer.canvas_->Invalidate()) {
+					continue ;
+				}
+
+				Rect clip = IntersectRect(now, screen) ;
+				for (const auto& r : layer.canvas_->GetDamage().GetRects()) {
+					damage_.Add(Rect(r.x + layer.pos_.x, r.y + layer.pos_.y, r.w, r.h), clip) ;
+				}
+			}
+		}
+
+		void ComposeRect(const Rect& area) noexcept {
+			PixelSpan dst = output_.Lock(area, PixelAccess::ReadWrite) ;
+			if (!dst.IsValid()) {
+				return ;
+			}
+
+			const Rect& a = dst.GetArea() ;
+
+			// layer opaque teratas yang menutup seluruh area : background dan semua layer
+			// di bawahnya tidak perlu disusun
+			size_t first = 0 ;
+			bool covered = false ;
+			for (size_t i = layers_.size(); i-- > 0;) {
+				if (ContainsRect(OpaqueBound(layers_[i]), a)) {
+					first = i ;
+					covered = true ;
+					break ;
+				}
+			}
+
+			if (covered) {
+				for (size_t i = 0; i < first; ++i) {
+					stats_.pixels_skipped_ += Area(IntersectRect(ScreenBound(layers_[i]), a)) ;
+				}
+			} else {
+				for (uint32_t y = 0; y < a.h; ++y) {
+					span_ops::fill(dst.GetRow(y), a.w, background_) ;
+				}
+			}
+
+			for (size_t i = first; i < layers_.size(); ++i) {
+				const Layer& layer = layers_[i] ;
+				Rect isect = IntersectRect(ScreenBound(layer), a) ;
+				for (size_t j = i + 1; j < layers_.size() && isect.w != 0; ++j) {
+					isect = Occlude(isect, OpaqueBound(layers_[j])) ;
+				}
+
+				if (isect.w == 0) {
+					continue ;
+				}
+
+				Rect local(isect.x - layer.pos_.x, isect.y - layer.pos_.y, isect.w, isect.h) ;
+				PixelSpan src = layer.canvas_->Lock(local, PixelAccess::Read) ;
+				if (!src.IsValid()) {
+					continue ;
+				}
+
+				// bagian source yang opaque disalin, sisanya di-blend
+				Rect solid = IntersectRect(OpaqueBound(layer), isect) ;
+				int32_t solid_x0 = solid.x - isect.x ;
+				int32_t solid_x1 = solid_x0 + static_cast<int32_t>(solid.w) ;
+				for (uint32_t y = 0; y < isect.h; ++y) {
+					uint32_t* row = dst.GetRow(static_cast<uint32_t>(isect.y - a.y) + y) + (isect.x - a.x) ;
+					const uint32_t* src_row = src.GetRow(y) ;
+					int32_t sy = isect.y + static_cast<int32_t>(y) ;
+					if (solid.w == 0 || sy < solid.y || sy >= solid.y + static_cast<int32_t>(solid.h)) {
+						span_ops::blend_row(row, src_row, isect.w, layer.opacity_) ;
+						stats_.pixels_blended_ += isect.w ;
+						continue ;
+					}
+
+					span_ops::blend_row(row, src_row, static_cast<size_t>(solid_x0), layer.opacity_) ;
+					span_ops::copy_row(row + solid_x0, src_row + solid_x0, solid.w) ;
+					span_ops::blend_row(row + solid_x1, src_row + solid_x1, isect.w - static_cast<uint32_t>(solid_x1), layer.opacity_) ;
+					stats_.pixels_copied_ += solid.w ;
+					stats_.pixels_blended_ += isect.w - solid.w ;
+				}
+				++stats_.blits_ ;
+			}
+
+			stats_.pixels_composed_ += static_cast<uint64_t>(a.w) * a.h ;
+			++stats_.rect_count_ ;
+		}
+
+	public :
+		Compositor(const Compositor&) = delete ;
+		Compositor& operator=(const Compositor&) = delete ;
+		Compositor() = default ;
+
+		// output selalu canvas software, isi lama dibuang dan frame berikutnya disusun penuh
+		bool Create(const Size& size) noexcept {
+			full_ = true ;
+			if (output_.IsValid() && output_.IsSoftware()) {
+				return output_.Resize(size) ;
+			}
+			return output_.Create(size, CanvasBackend::Software) ;
+		}
+
+		LayerId AddLayer(Canvas* canvas, const Point& pos = {}, uint8_t opacity = 255) noexcept {
+			try {
+				layers_.push_back({next_id_, canvas, pos, opacity, true, true, {}}) ;
+			} catch (...) {
+				return InvalidLayer ;
+			}
+			return next_id_++ ;
+		}
+
+		void RemoveLayer(LayerId id) noexcept {
+			for (size_t i = 0; i < layers_.size(); ++i) {
+				if (layers_[i].id_ == id) {
+					pending_.Add(layers_[i].last_) ;
+					layers_.erase(layers_.begin() + i) ;
+					return ;
+				}
+			}
+		}
+
+		void SetCanvas(LayerId id, Canvas* canvas) noexcept {
+			if (Layer* layer = Find(id); layer && layer->canvas_ != canvas) {
+				layer->canvas_ = canvas ;
+				layer->changed_ = true ;
+			}
+		}
+
+		void SetPosition(LayerId id, const Point& pos) noexcept {
+			if (Layer* layer = Find(id); layer && !(layer->pos_ == pos)) {
+				layer->pos_ = pos ;
+				layer->changed_ = true ;
+			}
+		}
+
+		void SetOpacity(LayerId id, uint8_t opacity) noexcept {
+			if (Layer* layer = Find(id); layer && layer->opacity_ != opacity) {
+				layer->opacity_ = opacity ;
+				layer->changed_ = true ;
+			}
+		}
+
+		void SetVisible(LayerId id, bool visible) noexcept {
+			if (Layer* layer = Find(id); layer && layer->visible_ != visible) {
+				layer->visible_ = visible ;
+				layer->changed_ = true ;
+			}
+		}
+
+		// pindahkan layer ke posisi index dalam urutan (0 = paling bawah)
+		void SetOrder(LayerId id, size_t index) noexcept {
+			for (size_t i = 0; i < layers_.size(); ++i) {
+				if (layers_[i].id_ != id) {
+					continue ;
+				}
+
+				index = std::min(index, layers_.size() - 1) ;
+				if (index == i) {
+					return ;
+				}
+
+				Layer moved = layers_[i] ;
+				moved.changed_ = true ;
+				layers_.erase(layers_.begin() + i) ;
+				layers_.insert(layers_.begin() + index, moved) ;
+				return ;
+			}
+		}
+
+		// susun ulang area layar tertentu pada Compose() berikutnya
+		void Invalidate(const Rect& area) noexcept { pending_.Add(area) ; }
+		void Invalidate() noexcept { full_ = true ; }
+
+		void SetBackground(const Color& color) noexcept {
+			background_ = ToPixel(color) ;
+			full_ = true ;
+		}
+
+		// false bila tidak ada yang berubah, output dan damage-nya tidak disentuh
+		bool Compose() noexcept {
+			stats_ = {} ;
+			damage_.Clear() ;
+			if (!output_.IsValid()) {
+				return false ;
+			}
+
+			Rect screen {0, 0, output_.GetWidth(), output_.GetHeight()} ;
+			CollectDamage(screen) ;
+
+			for (const auto& r : damage_.GetRects()) {
+				ComposeRect(r) ;
+			}
+
+			for (auto& layer : layers_) {
+				layer.last_ = ScreenBound(layer) ;
+				layer.changed_ = false ;
+				if (layer.canvas_) {
+					layer.canvas_->MarkValidate() ;
+				}
+			}
+
+			pending_.Clear() ;
+			full_ = false ;
+
+			#ifdef RENDERER_DEBUG
+				if (!damage_.IsEmpty()) {
+					logger::info("Compositor::Compose - Composed ", stats_.pixels_composed_, " pixels in ", stats_.rect_count_, " rect(s).") ;
+				}
+			#endif
+
+			return !damage_.IsEmpty() ;
+		}
+
+		// kirim area output yang berubah sejak present terakhir ke target (lihat PresentRegion)
+		template <typename Target>
+		PresentStats Present(Target& target, float threshold = DefaultPresentThreshold) noexcept {
+			PresentStats stats = PresentRegion(output_, output_.GetDamage(), target, threshold, present_rects_) ;
+			// present yang gagal (mis. GetDC gagal) menyimpan damage untuk present berikutnya
+			if (stats.presented_) {
+				output_.MarkValidate() ;
+			}
+			return stats ;
+		}
+
+	#ifdef ZKETCH_WIN32
+		PresentStats Present(HWND hwnd, float threshold = DefaultPresentThreshold) noexcept {
+			DibPresentTarget target(hwnd) ;
+			return Present(target, threshold) ;
+		}
+	#endif
+
+		Canvas& GetOutput() noexcept { return output_ ; }
+		const Canvas& GetOutput() const noexcept { return output_ ; }
+		const DamageRegion& GetDamage() const noexcept { return damage_ ; }
+		const CompositeStats& GetStats() const noexcept { return stats_ ; }
+		size_t GetLayerCount() const noexcept { return layers_.size() ; }
+	} ;
+}
\ No newline at end of file
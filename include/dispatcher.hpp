@@ -0,0 +1,280 @@
+#pragma once
+#include "event.hpp"
+
+namespace zketch {
+
+	// callable bool(const Event&) (true = event dikonsumsi) atau void(const Event&)
+	// yang disimpan langsung di buffer sendiri, tanpa alokasi heap seperti std::function.
+	// callable yang lebih besar dari BufferSize ditolak saat compile.
+	class EventHandler {
+	public :
+		static constexpr size_t BufferSize = 48 ;
+
+	private :
+		using InvokeFn = bool(*)(void*, const Event&) ;
+		// pindahkan src ke dst lalu hancurkan src, dst == nullptr : hancurkan src saja
+		using ManageFn = void(*)(void* dst, void* src) noexcept ;
+
+		alignas(std::max_align_t) unsigned char storage_[BufferSize] ;
+		InvokeFn invoke_ = nullptr ;
+		ManageFn manage_ = nullptr ;
+
+		void Reset() noexcept {
+			if (manage_) {
+				manage_(nullptr, storage_) ;
+			}
+			invoke_ = nullptr ;
+			manage_ = nullptr ;
+		}
+
+	public :
+		EventHandler() noexcept = default ;
+		EventHandler(const EventHandler&) = delete ;
+		EventHandler& operator=(const EventHandler&) = delete ;
+
+		template <typename F, typename Fn = std::decay_t<F>, typename = std::enable_if_t<!std::is_same_v<Fn, EventHandler>>>
+		EventHandler(F&& fn) noexcept(std::is_nothrow_constructible_v<Fn, F>) {
+			static_assert(sizeof(Fn) <= BufferSize && alignof(Fn) <= alignof(std::max_align_t), "EventHandler: callable too large for the inline buffer") ;
+			static_assert(std::is_nothrow_move_constructible_v<Fn>, "EventHandler: callable must be nothrow move constructible") ;
+			static_assert(std::is_invocable_v<Fn&, const Event&>, "EventHandler: callable must accept const Event&") ;
+
+			::new (static_cast<void*>(storage_)) Fn(std::forward<F>(fn)) ;
+			invoke_ = [](void* self, const Event& e) -> bool {
+				if constexpr (std::is_convertible_v<std::invoke_result_t<Fn&, const Event&>, bool>) {
+					return static_cast<bool>((*static_cast<Fn*>(self))(e)) ;
+				} else {
+					(*static_cast<Fn*>(self))(e) ;
+					return false ;
+				}
+			} ;
+			manage_ = [](void* dst, void* src) noexcept {
+				Fn* from = static_cast<Fn*>(src) ;
+				if (dst) {
+					::new (dst) Fn(std::move(*from)) ;
+				}
+				from->~Fn() ;
+			} ;
+		}
+
+		EventHandler(EventHandler&& o) noexcept : invoke_(o.invoke_), manage_(o.manage_) {
+			if (manage_) {
+				manage_(storage_, o.storage_) ;
+			}
+			o.invoke_ = nullptr ;
+			o.manage_ = nullptr ;
+		}
+
+		EventHandler& operator=(EventHandler&& o) noexcept {
+			if (this != &o) {
+				Reset() ;
+				invoke_ = o.invoke_ ;
+				manage_ = o.manage_ ;
+				if (manage_) {
+					manage_(storage_, o.storage_) ;
+				}
+				o.invoke_ = nullptr ;
+				o.manage_ = nullptr ;
+			}
+			return *this ;
+		}
+
+		~EventHandler() noexcept {
+			Reset() ;
+		}
+
+		bool operator()(const Event& e) { return invoke_(storage_, e) ; }
+		explicit operator bool() const noexcept { return invoke_ != nullptr ; }
+	} ;
+
+	using SubscriptionId = uint32_t ;
+	inline constexpr SubscriptionId InvalidSubscriptionId = 0 ;
+
+	// subscriber per EventType dalam array kontigu, urut priority (besar dulu), priority
+	// sama urut subscribe. Dispatch hanya menyentuh tabel tipe event itu dan berhenti
+	// di handler pertama yang mengembalikan true (consumed).
+	// Subscribe / Unsubscribe dari dalam handler aman : subscribe baru berlaku untuk
+	// event berikutnya, unsubscribe langsung mematikan handler.
+	class EventDispatcher {
+	public :
+		static constexpr size_t TypeCount = static_cast<size_t>(EventType::Button) + 1 ;
+
+	private :
+		struct Entry {
+			SubscriptionId id_ ;
+			int32_t priority_ ;
+			EventHandler handler_ ;
+		} ;
+
+		struct Pending {
+			EventType type_ ;
+			Entry entry_ ;
+		} ;
+
+		std::array<std::vector<Entry>, TypeCount> tables_ ;
+		std::vector<Pending> pending_ ;
+		SubscriptionId next_id_ = 1 ;
+		uint32_t depth_ = 0 ;
+		bool has_dead_ = false ;
+
+		static size_t IndexOf(EventType type) noexcept { return static_cast<size_t>(type) ; }
+
+		void Insert(EventType type, Entry&& entry) {
+			std::vector<Entry>& table = tables_[IndexOf(type)] ;
+			auto it = std::upper_bound(table.begin(), table.end(), entry.priority_, [](int32_t priority, const Entry& e) {
+				return priority > e.priority_ ;
+			}) ;
+			table.insert(it, std::move(entry)) ;
+		}
+
+		// setelah dispatch terluar selesai : buang yang mati, masukkan yang tertunda
+		void Settle() noexcept {
+			if (has_dead_) {
+				for (auto& table : tables_) {
+					std::erase_if(table, [](const Entry& e) { return e.id_ == InvalidSubscriptionId ; }) ;
+				}
+				has_dead_ = false ;
+			}
+
+			for (Pending& p : pending_) {
+				try {
+					Insert(p.type_, std::move(p.entry_)) ;
+				} catch (...) {
+
+					#ifdef EVENTSYSTEM_DEBUG
+						logger::error("EventDispatcher::Settle - Out of memory, subscription lost.") ;
+					#endif
+
+				}
+			}
+			pending_.clear() ;
+		}
+
+	public :
+		EventDispatcher() = default ;
+		EventDispatcher(const EventDispatcher&) = delete ;
+		EventDispatcher& operator=(const EventDispatcher&) = delete ;
+
+		// InvalidSubscriptionId bila gagal
+		template <typename F>
+		SubscriptionId Subscribe(EventType type, F&& fn, int32_t priority = 0) noexcept {
+			if (IndexOf(type) >= TypeCount) {
+				return InvalidSubscriptionId ;
+			}
+
+			SubscriptionId id = next_id_++ ;
+			try {
+				Entry entry {id, priority, EventHandler(std::forward<F>(fn))} ;
+				if (depth_ > 0) {
+					pending_.push_back({type, std::move(entry)}) ;
+				} else {
+					Insert(type, std::move(entry)) ;
+				}
+			} catch (...) {
+
+				#ifdef EVENTSYSTEM_DEBUG
+					logger::error("EventDispatcher::Subscribe - Out of memory.") ;
+				#endif
+
+				return InvalidSubscriptionId ;
+			}
+			return id ;
+		}
+
+		void Unsubscribe(SubscriptionId id) noexcept {
+			if (id == InvalidSubscriptionId) {
+				return ;
+			}
+
+			for (auto& table : tables_) {
+				for (size_t i = 0; i < table.size(); ++i) {
+					if (table[i].id_ != id) {
+						continue ;
+					}
+
+					if (depth_ > 0) {
+						table[i].id_ = InvalidSubscriptionId ;
+						has_dead_ = true ;
+					} else {
+						table.erase(table.begin() + i) ;
+					}
+					return ;
+				}
+			}
+
+			std::erase_if(pending_, [id](const Pending& p) { return p.entry_.id_ == id ; }) ;
+		}
+
+		// true bila ada handler yang mengonsumsi e
+		bool Dispatch(const Event& e) {
+			size_t index = IndexOf(e.GetEventType()) ;
+			if (index >= TypeCount || tables_[index].empty()) {
+				return false ;
+			}
+
+			std::vector<Entry>& table = tables_[index] ;
+			bool consumed = false ;
+			++depth_ ;
+			try {
+				for (size_t i = 0; i < table.size(); ++i) {
+					if (table[i].id_ != InvalidSubscriptionId && table[i].handler_(e)) {
+						consumed = true ;
+						break ;
+					}
+				}
+			} catch (...) {
+				if (--depth_ == 0) {
+					Settle() ;
+				}
+				throw ;
+			}
+
+			if (--depth_ == 0) {
+				Settle() ;
+			}
+			return consumed ;
+		}
+
+		// untuk burst dari EventSystem::PollEvents, return jumlah event yang dikonsumsi
+		size_t Dispatch(std::span<const Event> events) {
+			size_t consumed = 0 ;
+			for (const Event& e : events) {
+				consumed += Dispatch(e) ? 1 : 0 ;
+			}
+			return consumed ;
+		}
+
+		void Clear(EventType type) noexcept {
+			if (IndexOf(type) >= TypeCount) {
+				return ;
+			}
+
+			if (depth_ > 0) {
+				for (Entry& entry : tables_[IndexOf(type)]) {
+					entry.id_ = InvalidSubscriptionId ;
+				}
+				has_dead_ = true ;
+			} else {
+				tables_[IndexOf(type)].clear() ;
+			}
+			std::erase_if(pending_, [type](const Pending& p) { return p.type_ == type ; }) ;
+		}
+
+		void Clear() noexcept {
+			for (size_t i = 0; i < TypeCount; ++i) {
+				Clear(static_cast<EventType>(i)) ;
+			}
+		}
+
+		size_t GetSubscriberCount(EventType type) const noexcept {
+			if (IndexOf(type) >= TypeCount) {
+				return 0 ;
+			}
+
+			size_t n = 0 ;
+			for (const Entry& entry : tables_[IndexOf(type)]) {
+				n += entry.id_ != InvalidSubscriptionId ? 1 : 0 ;
+			}
+			return n ;
+		}
+	} ;
+}
\ No newline at end of file
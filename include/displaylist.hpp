@@ -0,0 +1,219 @@
+#pragma once
+#include "font.hpp"
+
+namespace zketch {
+
+	// Color disimpan sebagai ABGR mentah karena Color tidak trivially copyable
+	// command buffer kontigu : [Header][payload][data tambahan] ... tiap command di-pad ke 8 byte
+	class DisplayList {
+	public :
+		struct Header {
+			DrawOp op_ ;
+			uint32_t size_ ;
+		} ;
+
+		struct ClearCmd {
+			uint32_t color_ ;
+		} ;
+
+		// dipakai bersama oleh rect, rounded rect dan ellipse
+		struct ShapeCmd {
+			RectF rect_ ;
+			uint32_t color_ ;
+			float thickness_ ;
+			float radius_ ;
+		} ;
+
+		struct LineCmd {
+			Point start_ ;
+			Point end_ ;
+			uint32_t color_ ;
+			float thickness_ ;
+		} ;
+
+		// diikuti count_ buah PointF
+		struct PolygonCmd {
+			uint32_t color_ ;
+			float thickness_ ;
+			uint32_t count_ ;
+		} ;
+
+		// diikuti length_ buah wchar_t, nama font tidak di-copy (Font juga hanya view)
+		struct StringCmd {
+			Point pos_ ;
+			uint32_t color_ ;
+			const wchar_t* font_name_ ;
+			uint32_t font_name_length_ ;
+			float font_size_ ;
+			FontStyle font_style_ ;
+			uint32_t length_ ;
+		} ;
+
+		struct CanvasCmd {
+			const Canvas* src_ ;
+			Point pos_ ;
+		} ;
+
+	private :
+		static constexpr size_t CommandAlign = 8 ;
+
+		std::vector<std::byte> buffer_ ;
+		size_t count_ = 0 ;
+		uint64_t key_ = 0 ;
+		bool valid_ = false ;
+		bool recording_ = false ;
+
+		static constexpr size_t AlignUp(size_t v) noexcept {
+			return (v + CommandAlign - 1) & ~(CommandAlign - 1) ;
+		}
+
+		template <typename Cmd>
+		void Push(DrawOp op, const Cmd& cmd, const void* extra = nullptr, size_t extra_bytes = 0) noexcept {
+			static_assert(std::is_trivially_copyable_v<Cmd>, "DisplayList command must be trivially copyable") ;
+
+			size_t payload = AlignUp(sizeof(Header)) + sizeof(Cmd) + extra_bytes ;
+			size_t total = AlignUp(payload) ;
+			size_t offset = buffer_.size() ;
+
+			try {
+				buffer_.resize(offset + total) ;
+			} catch (...) {
+
+				#ifdef DISPLAYLIST_DEBUG
+					logger::error("DisplayList::Push - Failed to grow command buffer.") ;
+				#endif
+
+				return ;
+			}
+
+			Header header {op, static_cast<uint32_t>(total)} ;
+			std::byte* dst = buffer_.data() + offset ;
+			std::memcpy(dst, &header, sizeof(Header)) ;
+			std::memcpy(dst + AlignUp(sizeof(Header)), &cmd, sizeof(Cmd)) ;
+			if (extra_bytes) {
+				std::memcpy(dst + AlignUp(sizeof(Header)) + sizeof(Cmd), extra, extra_bytes) ;
+			}
+			++count_ ;
+		}
+
+	public :
+		DisplayList() = default ;
+		DisplayList(const DisplayList&) = default ;
+		DisplayList& operator=(const DisplayList&) = default ;
+		DisplayList(DisplayList&&) noexcept = default ;
+		DisplayList& operator=(DisplayList&&) noexcept = default ;
+
+		// FNV-1a atas byte nilai-nilai input yang menentukan isi list. tipe dengan padding
+		// ditolak karena byte padding-nya acak (key jadi tidak deterministik), hash field-nya
+		// satu per satu. -0.0f disamakan dengan +0.0f.
+		template <typename ... Ts>
+		static uint64_t MakeKey(const Ts& ... values) noexcept {
+			static_assert(((std::has_unique_object_representations_v<Ts> || std::is_floating_point_v<Ts>) && ...), "DisplayList key input must not contain padding, hash its fields instead") ;
+
+			uint64_t h = 14695981039346656037ull ;
+			auto mix = [&h](auto v) {
+				if constexpr (std::is_floating_point_v<decltype(v)>) {
+					v += decltype(v)(0) ;
+				}
+				const auto* p = reinterpret_cast<const unsigned char*>(&v) ;
+				for (size_t i = 0; i < sizeof(v); ++i) {
+					h ^= p[i] ;
+					h *= 1099511628211ull ;
+				}
+			} ;
+			(mix(values), ...) ;
+			return h ;
+		}
+
+		// kapasitas buffer dipertahankan supaya perekaman ulang tidak alokasi
+		void BeginRecord(uint64_t key = 0) noexcept {
+			buffer_.clear() ;
+			count_ = 0 ;
+			key_ = key ;
+			valid_ = false ;
+			recording_ = true ;
+		}
+
+		void EndRecord() noexcept {
+			recording_ = false ;
+			valid_ = true ;
+		}
+
+		void Reset() noexcept {
+			buffer_.clear() ;
+			count_ = 0 ;
+			key_ = 0 ;
+			valid_ = false ;
+			recording_ = false ;
+		}
+
+		void Invalidate() noexcept { valid_ = false ; }
+
+		bool IsValid() const noexcept { return valid_ ; }
+		bool IsValid(uint64_t key) const noexcept { return valid_ && key_ == key ; }
+		bool IsRecording() const noexcept { return recording_ ; }
+		bool IsEmpty() const noexcept { return count_ == 0 ; }
+		size_t GetCommandCount() const noexcept { return count_ ; }
+		size_t GetByteSize() const noexcept { return buffer_.size() ; }
+		uint64_t GetKey() const noexcept { return key_ ; }
+
+		void PushClear(const Color& color) noexcept {
+			Push(DrawOp::Clear, ClearCmd{color.ABGR}) ;
+		}
+
+		void PushShape(DrawOp op, const RectF& rect, const Color& color, float thickness = 0.0f, float radius = 0.0f) noexcept {
+			Push(op, ShapeCmd{rect, color.ABGR, thickness, radius}) ;
+		}
+
+		void PushLine(const Point& start, const Point& end, const Color& color, float thickness) noexcept {
+			Push(DrawOp::DrawLine, LineCmd{start, end, color.ABGR, thickness}) ;
+		}
+
+		void PushPolygon(DrawOp op, const PointF* points, size_t count, const Color& color, float thickness = 0.0f) noexcept {
+			Push(op, PolygonCmd{color.ABGR, thickness, static_cast<uint32_t>(count)}, points, count * sizeof(PointF)) ;
+		}
+
+		void PushString(const wchar_t* text, size_t length, const Point& pos, const Color& color, const Font& font) noexcept {
+			const auto& name = font.GetFontName() ;
+			StringCmd cmd {
+				pos,
+				color.ABGR,
+				name.data(),
+				static_cast<uint32_t>(name.size()),
+				font.GetFontSize(),
+				font.GetFontStyle(),
+				static_cast<uint32_t>(length)
+			} ;
+			Push(DrawOp::DrawString, cmd, text, length * sizeof(wchar_t)) ;
+		}
+
+		void PushCanvas(const Canvas* src, const Point& pos) noexcept {
+			Push(DrawOp::DrawCanvas, CanvasCmd{src, pos}) ;
+		}
+
+		// fn(DrawOp, const std::byte* payload), payload dibaca dengan Read<Cmd>()
+		template <typename Fn>
+		void ForEach(Fn&& fn) const {
+			size_t offset = 0 ;
+			while (offset + sizeof(Header) <= buffer_.size()) {
+				Header header ;
+				std::memcpy(&header, buffer_.data() + offset, sizeof(Header)) ;
+				fn(header.op_, buffer_.data() + offset + AlignUp(sizeof(Header))) ;
+				offset += header.size_ ;
+			}
+		}
+
+		template <typename Cmd>
+		static Cmd Read(const std::byte* payload) noexcept {
+			Cmd cmd ;
+			std::memcpy(&cmd, payload, sizeof(Cmd)) ;
+			return cmd ;
+		}
+
+		// data tambahan (PointF / wchar_t) tepat setelah struct command
+		template <typename Cmd, typename T>
+		static const T* ReadExtra(const std::byte* payload) noexcept {
+			return reinterpret_cast<const T*>(payload + sizeof(Cmd)) ;
+		}
+	} ;
+}
\ No newline at end of file
@@ -6,6 +6,8 @@
 
 namespace zketch {
 
+	#ifdef ZKETCH_WIN32
+
 	// Enum WindowStyle modern + combos
 	enum class WindowStyle : uint32_t {
 		// Single flags
@@ -44,6 +46,8 @@ namespace zketch {
 		return a ;
 	}
 
+	#endif
+
 	template <typename From, typename To = int32_t, typename = std::enable_if_t<std::is_integral_v<To> && std::is_convertible_v<From, To>>>
 	inline To FromFlag(From from) noexcept {
 		return static_cast<To>(from) ;
@@ -207,6 +211,52 @@ namespace zketch {
 		Hover
 	} ;
 
+	enum class CanvasBackend : uint8_t {
+		GdiPlus,
+		Software
+	} ;
+
+	enum class WaitMode : uint8_t {
+		Poll,
+		Block
+	} ;
+
+	// perilaku push ke antrian yang penuh
+	enum class OverflowPolicy : uint8_t {
+		Reject,     // item baru dibuang
+		DropOldest, // item paling lama dibuang untuk memberi tempat
+		Spin        // tunggu (yield) sampai consumer memberi tempat
+	} ;
+
+	// event input beruntun yang boleh digabung oleh EventSystem::PollEvent
+	enum class Coalesce : uint8_t {
+		None		= 0,
+		MouseMove	= 1 << 0, // ambil posisi terakhir
+		Wheel		= 1 << 1, // jumlahkan delta
+		All			= MouseMove | Wheel
+	} ;
+
+	enum class PixelAccess : uint8_t {
+		Read		= 1 << 0,
+		Write		= 1 << 1,
+		ReadWrite	= Read | Write
+	} ;
+
+	enum class DrawOp : uint8_t {
+		Clear,
+		DrawRect,
+		FillRect,
+		DrawRectRounded,
+		FillRectRounded,
+		DrawEllipse,
+		FillEllipse,
+		DrawString,
+		DrawPolygon,
+		FillPolygon,
+		DrawLine,
+		DrawCanvas
+	} ;
+
 	enum class FontStyle : uint8_t {
         Regular,
         Bold,
@@ -257,4 +307,12 @@ namespace zketch {
 		a = a & b ;
 		return a ;
 	}
+
+	constexpr Coalesce operator|(Coalesce a, Coalesce b) noexcept {
+		return static_cast<Coalesce>(static_cast<uint8_t>(a) | static_cast<uint8_t>(b)) ;
+	}
+
+	constexpr Coalesce operator&(Coalesce a, Coalesce b) noexcept {
+		return static_cast<Coalesce>(static_cast<uint8_t>(a) & static_cast<uint8_t>(b)) ;
+	}
 }
\ No newline at end of file
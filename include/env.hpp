@@ -1,6 +1,18 @@
 #pragma once
 
+#if defined (_WIN32) || defined (_WIN64)
+	#define ZKETCH_WIN32
+#endif
+
 #include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+#include <new>
+#include <vector>
+#include <array>
+#include <string_view>
 #include <limits>
 #include <type_traits>
 #include <utility>
@@ -16,11 +28,18 @@
 #include <string>
 #include <algorithm>
 #include <queue>
+#include <deque>
+#include <list>
 #include <set>
 #include <unordered_set>
 #include <unordered_map>
 #include <iostream>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <bit>
+#include <span>
 #include <chrono>
 
 namespace zketch {
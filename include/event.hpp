@@ -1,8 +1,15 @@
 #pragma once
 #include "unit.hpp"
+#include "mpscring.hpp"
+#include "latency.hpp"
 
 namespace zketch {
 
+	#ifndef ZKETCH_WIN32
+		// di luar Win32 handle window hanya penanda sumber event
+		using HWND = void* ;
+	#endif
+
 	namespace error_handler {
 		struct invalid_event_type {
 			const char* what() const noexcept {
@@ -13,6 +20,8 @@ namespace zketch {
 
 	class Event {
 		friend inline bool PollEvent(Event&) ;
+		friend inline size_t PumpMessages(bool&) ;
+		friend class EventSystem ;
 
 	private :
 		EventType type_ = EventType::None ;
@@ -52,6 +61,27 @@ namespace zketch {
 			} button_ ;
 		} data_ ;
 
+		// event baru dicap dengan EventClockNow (kecuali saat evaluasi constexpr)
+		constexpr void Stamp() noexcept {
+			if (!std::is_constant_evaluated()) {
+				timestamp_ = EventClockNow() ;
+			}
+		}
+
+	#ifdef ZKETCH_WIN32
+		// MSG::time (ms GetTickCount, resolusi ~10-16 ms) diubah ke jam event dengan
+		// mengurangi umur pesan di antrian OS dari waktu sekarang
+		static uint64_t StampFromMessageTime(DWORD time) noexcept {
+			uint64_t now = EventClockNow() ;
+			DWORD age = GetTickCount() - time ;
+			// bukan dari GetTickCount (mis. pesan buatan PostMessage lama), abaikan
+			if (age > 10000) {
+				return now ;
+			}
+			return now - std::min<uint64_t>(now, static_cast<uint64_t>(age) * 1000000) ;
+		}
+	#endif
+
 		// -------------- Construtor  --------------
 
 		constexpr Event(HWND src_, EventType type_) {
@@ -61,12 +91,14 @@ namespace zketch {
 			}
 			data_.empty_ = {} ;
 			hwnd_ = src_ ;
+			Stamp() ;
 		}
 
 		constexpr Event(HWND src, const Size& size) noexcept {
 			type_ = EventType::Resize ;
 			data_.resize_ = {size.x, size.y} ;
 			hwnd_ = src ;
+			Stamp() ;
 		}
 
 		constexpr Event(HWND src, KeyState state, uint32_t key_code) {
@@ -78,6 +110,7 @@ namespace zketch {
 			data_.key_.state_ = state ;
 			data_.key_.key_code_ = key_code ;
 			hwnd_ = src ;
+			Stamp() ;
 		}
 
 		constexpr Event(HWND src, MouseButton button, MouseState state, const Point& pos, int32_t value = 0) {
@@ -112,6 +145,7 @@ namespace zketch {
 				} ;
 			}
 			hwnd_ = src ;
+			Stamp() ;
 		}
 
 		constexpr Event(SliderState state, float value, Slider* slider_ptr = nullptr) noexcept {
@@ -122,6 +156,7 @@ namespace zketch {
 				slider_ptr
 			} ;
 			hwnd_ = nullptr ;
+			Stamp() ;
 		}
 
 		constexpr Event(ButtonState state, Button* button_ptr = nullptr) noexcept {
@@ -130,9 +165,11 @@ namespace zketch {
 				state,
 				button_ptr
 			} ;
+			Stamp() ;
 		}
 
-		static constexpr Event CreateEventFromMSG(const MSG& msg) noexcept {
+	#ifdef ZKETCH_WIN32
+		static constexpr Event TranslateMSG(const MSG& msg) noexcept {
 			switch (msg.message) {
 				case WM_KEYDOWN : 
 					return Event::CreateKeyEvent(msg.hwnd, KeyState::Down, msg.wParam) ; 
@@ -162,6 +199,13 @@ namespace zketch {
 			return Event::CreateCommonEvent(msg.hwnd, EventType::None) ;
 		}
 
+		static Event CreateEventFromMSG(const MSG& msg) noexcept {
+			Event e = TranslateMSG(msg) ;
+			e.timestamp_ = StampFromMessageTime(msg.time) ;
+			return e ;
+		}
+	#endif
+
 	public :
 		constexpr Event() noexcept : type_(EventType::None), hwnd_(nullptr) {
 			data_.empty_ = {} ;
@@ -253,10 +297,16 @@ namespace zketch {
 			return type_ ;
 		}
 
+		// nanodetik, sejajar dengan EventClockNow
 		uint64_t GetTimeStamp() const noexcept {
 			return timestamp_ ;
 		}
 
+		// waktu event sejak dibuat, dalam ms
+		double GetAge(uint64_t now = EventClockNow()) const noexcept {
+			return now > timestamp_ ? static_cast<double>(now - timestamp_) / 1.0e6 : 0.0 ;
+		}
+
 		HWND GetHandle() const noexcept {
 			return hwnd_ ;
 		}
@@ -284,11 +334,125 @@ namespace zketch {
 		}
 	} ;
 
+	// bitmask EventType untuk EventSystem::PollEvents
+	using EventFilter = uint32_t ;
+	inline constexpr EventFilter EventFilterAll = 0xFFFFFFFF ;
+
+	template <typename... Types>
+	constexpr EventFilter FilterOf(EventType type, Types... rest) noexcept {
+		return (EventFilter(1) << static_cast<uint8_t>(type)) | (0 | ... | (EventFilter(1) << static_cast<uint8_t>(rest))) ;
+	}
+
+	// WaitEvent tanpa batas waktu
+	inline constexpr uint32_t WaitInfinite = 0xFFFFFFFF ;
+
+#ifndef ZKETCH_WIN32
+	// pengganti auto-reset event Win32 untuk WaitEvent di luar Win32 : Notify dari
+	// thread mana pun membangunkan satu WaitUntil, sinyal tetap tersimpan bila belum ada
+	// yang menunggu.
+	class WakeSignal {
+	private :
+		std::mutex mutex_ ;
+		std::condition_variable cv_ ;
+		bool signaled_ = false ;
+
+	public :
+		WakeSignal() = default ;
+		WakeSignal(const WakeSignal&) = delete ;
+		WakeSignal& operator=(const WakeSignal&) = delete ;
+
+		void Notify() noexcept {
+			{
+				std::lock_guard<std::mutex> lock(mutex_) ;
+				signaled_ = true ;
+			}
+			cv_.notify_one() ;
+		}
+
+		// true bila dibangunkan Notify, false bila deadline lewat
+		bool WaitUntil(std::chrono::steady_clock::time_point deadline) noexcept {
+			std::unique_lock<std::mutex> lock(mutex_) ;
+			if (deadline == std::chrono::steady_clock::time_point::max()) {
+				cv_.wait(lock, [this] { return signaled_ ; }) ;
+			} else if (!cv_.wait_until(lock, deadline, [this] { return signaled_ ; })) {
+				return false ;
+			}
+			signaled_ = false ;
+			return true ;
+		}
+	} ;
+#endif
+
 	class EventSystem {
+	public :
+		static constexpr size_t QueueCapacity = 4096 ;
+		static constexpr size_t MaxCoalescedSamples = 256 ;
+		using InputObserver = void(*)(const Event&) noexcept ;
+
 	private :
-		static inline std::queue<Event> g_events_ ;
+		// diisi dari thread mana pun, dikonsumsi hanya oleh thread UI
+		static inline MpscRing<Event, QueueCapacity> g_events_ ;
+		// event yang sudah diambil dari ring tapi belum dikembalikan (PeekEvent, penggabungan,
+		// sisa PollEvents yang tidak lolos filter), dibaca sebelum ring. hanya thread UI
+		static inline std::vector<Event> g_held_ ;
+		static inline size_t g_held_head_ = 0 ;
+		// mode penggabungan mouse, dan sampel asli dari event terakhir yang digabung. hanya thread UI
+		static inline Coalesce g_coalesce_ = Coalesce::None ;
+		static inline std::vector<Event> g_samples_ ;
+		static inline InputObserver g_observer_ = nullptr ;
+		static inline std::chrono::steady_clock::time_point g_wake_at_ = std::chrono::steady_clock::time_point::max() ;
 		static inline bool event_was_initialized_ = false ;
 
+		static bool HasHeld() noexcept { return g_held_head_ < g_held_.size() ; }
+
+		static bool TakeNext(Event& e) noexcept {
+			if (HasHeld()) {
+				e = g_held_[g_held_head_++] ;
+				if (!HasHeld()) {
+					g_held_.clear() ;
+					g_held_head_ = 0 ;
+				}
+				return true ;
+			}
+			return g_events_.TryPop(e) ;
+		}
+
+		// kembalikan e ke depan antrian. e selalu event terakhir dari TakeNext,
+		// jadi slot sebelum g_held_head_ kosong atau g_held_ kosong.
+		static void PutBack(const Event& e) noexcept {
+			if (g_held_head_ > 0) {
+				g_held_[--g_held_head_] = e ;
+				return ;
+			}
+			Hold(e) ;
+		}
+
+		static void Hold(const Event& e) noexcept {
+			try {
+				g_held_.push_back(e) ;
+			} catch (...) {
+
+				#ifdef EVENTSYSTEM_DEBUG
+					logger::error("EventSystem::Hold - Out of memory, event dropped.") ;
+				#endif
+
+			}
+		}
+
+		static void Observe(const Event& e) noexcept {
+			if (g_observer_ && (e.IsMouseEvent() || e.IsKeyEvent())) {
+				g_observer_(e) ;
+			}
+		}
+
+		static void KeepSample(const Event& e) noexcept {
+			if (g_samples_.size() < MaxCoalescedSamples) {
+				try {
+					g_samples_.push_back(e) ;
+				} catch (...) {}
+			}
+		}
+
 	public :
 		EventSystem() = delete ;
 		EventSystem(const EventSystem&) = delete ;
@@ -309,12 +473,109 @@ namespace zketch {
 			logger::info("EventSystem::Initialize - Event system was initialized.") ;
 		}
 
-		static void PushEvent(const Event& e) noexcept {
-			g_events_.push(e) ;
+		// aman dipanggil dari thread mana pun. false bila antrian penuh dan policy-nya
+		// Reject (event ini dibuang, lihat GetDropped)
+		static bool PushEvent(const Event& e) noexcept {
+			if (!g_events_.Push(e)) {
+
+				#ifdef EVENTSYSTEM_DEBUG
+					logger::warning("EventSystem::PushEvent - Queue full, event dropped.") ;
+				#endif
+
+				return false ;
+			}
+			return true ;
+		}
+
+		// PushEvent yang juga membangunkan WaitEvent di thread UI
+		static bool PostEvent(const Event& e) noexcept {
+			if (!PushEvent(e)) {
+				return false ;
+			}
+			Wake() ;
+			return true ;
+		}
+
+		static void SetOverflowPolicy(OverflowPolicy policy) noexcept { g_events_.SetOverflowPolicy(policy) ; }
+		static OverflowPolicy GetOverflowPolicy() noexcept { return g_events_.GetOverflowPolicy() ; }
+		static uint64_t GetDropped() noexcept { return g_events_.GetDropped() ; }
+
+	#ifdef ZKETCH_WIN32
+		// auto-reset event yang di-set oleh PostEvent / Wake
+		static HANDLE GetWakeHandle() noexcept {
+			static HANDLE wake = CreateEventW(nullptr, FALSE, FALSE, nullptr) ;
+			return wake ;
+		}
+	#else
+		// pengganti GetWakeHandle, di-notify oleh PostEvent / Wake
+		static WakeSignal& GetWakeSignal() noexcept {
+			static WakeSignal wake ;
+			return wake ;
+		}
+	#endif
+
+		// bangunkan WaitEvent di thread UI tanpa event, aman dari thread mana pun
+		static void Wake() noexcept {
+			#ifdef ZKETCH_WIN32
+				SetEvent(GetWakeHandle()) ;
+			#else
+				GetWakeSignal().Notify() ;
+			#endif
+		}
+
+		// WaitEvent kembali paling lambat pada deadline ini (mis. frame animasi berikutnya),
+		// deadline paling awal yang dipakai dan dihapus setelah tercapai. hanya thread UI.
+		static void ScheduleWake(std::chrono::steady_clock::time_point deadline) noexcept {
+			g_wake_at_ = std::min(g_wake_at_, deadline) ;
 		}
 
+		static std::chrono::steady_clock::time_point GetScheduledWake() noexcept { return g_wake_at_ ; }
+
+		static bool HasPending() noexcept { return HasHeld() || !g_events_.IsEmpty() ; }
+
+		static void ClearScheduledWake() noexcept { g_wake_at_ = std::chrono::steady_clock::time_point::max() ; }
+
+		// opt-in, default Coalesce::None (semua event mouse diteruskan apa adanya)
+		static void SetCoalescing(Coalesce mode) noexcept {
+			g_coalesce_ = mode ;
+			g_samples_.clear() ;
+			if (mode != Coalesce::None) {
+				try {
+					g_samples_.reserve(MaxCoalescedSamples) ;
+				} catch (...) {}
+			}
+		}
+
+		static Coalesce GetCoalescing() noexcept { return g_coalesce_ ; }
+
+		// dipanggil untuk setiap event mouse / key yang dikembalikan PollEvent / PollEvents
+		// (dipakai Window untuk pelacakan latensi). nullptr = tidak ada
+		static void SetInputObserver(InputObserver observer) noexcept { g_observer_ = observer ; }
+		static InputObserver GetInputObserver() noexcept { return g_observer_ ; }
+
+		// b boleh dilebur ke a : sama-sama mouse move / wheel untuk window yang sama
+		static bool CanCoalesce(const Event& a, const Event& b, Coalesce mode) noexcept {
+			if (!a.IsMouseEvent() || !b.IsMouseEvent() || a.GetHandle() != b.GetHandle() || a.GetMouseState() != b.GetMouseState()) {
+				return false ;
+			}
+
+			switch (a.GetMouseState()) {
+				case MouseState::None : return (mode & Coalesce::MouseMove) != Coalesce::None ;
+				case MouseState::Wheel : return (mode & Coalesce::Wheel) != Coalesce::None ;
+				default : return false ;
+			}
+		}
+
+		// sampel asli (urut, termasuk yang terakhir, maks. MaxCoalescedSamples) dari event yang baru dikembalikan PollEvent,
+		// kosong bila event itu tidak hasil penggabungan. valid sampai PollEvent berikutnya.
+		static const std::vector<Event>& GetCoalescedSamples() noexcept { return g_samples_ ; }
+
+		// resize beruntun untuk window yang sama cukup diwakili ukuran terakhir.
+		// bila SetCoalescing aktif, mouse move beruntun diwakili posisi terakhir dan
+		// wheel beruntun dijumlahkan deltanya (posisi terakhir, timestamp sampel pertama).
 		static bool PollEvent(Event& e) noexcept {
-			if (g_events_.empty()) { 
+			g_samples_.clear() ;
+			if (!TakeNext(e)) { 
 
 				#ifdef EVENTSYSTEM_DEBUG
 					logger::info("EventSystem::PollEvent - Event is empty.") ;
@@ -323,24 +584,141 @@ namespace zketch {
 				return false ; 
 			}
 
-            e = g_events_.front() ;
-            g_events_.pop() ;
+			if (e.IsResizeEvent()) {
+				Event next ;
+				while (TakeNext(next)) {
+					if (!next.IsResizeEvent() || next.GetHandle() != e.GetHandle()) {
+						PutBack(next) ;
+						break ;
+					}
+					e = next ;
+				}
+			} else if (g_coalesce_ != Coalesce::None && e.IsMouseEvent()) {
+				Event next ;
+				while (TakeNext(next)) {
+					if (!CanCoalesce(e, next, g_coalesce_)) {
+						PutBack(next) ;
+						break ;
+					}
+
+					if (g_samples_.empty()) {
+						KeepSample(e) ;
+					}
+					KeepSample(next) ;
+
+					if (next.GetMouseState() == MouseState::Wheel) {
+						next.data_.mouse_.value_ += e.data_.mouse_.value_ ;
+					}
+					// timestamp tetap milik sampel pertama (input yang paling lama menunggu)
+					next.timestamp_ = e.timestamp_ ;
+					e = next ;
+				}
+			}
+
+			Observe(e) ;
             return true ;
 		}
 
+		// ambil sampai out.size() event sekaligus (satu CAS ke ring per burst). event yang
+		// tipenya tidak lolos filter dilewati dan disimpan di depan antrian dengan urutan
+		// semula, jadi consumer Mouse saja tetap dapat event Mouse walau ada Key di depannya.
+		// yang disimpan dibatasi QueueCapacity, sesudahnya scan berhenti. tanpa penggabungan.
+		static size_t PollEvents(std::span<Event> out, EventFilter filter = EventFilterAll) noexcept {
+			g_samples_.clear() ;
+			size_t n = 0 ;
+
+			// event tertahan : yang lolos ke out, sisanya dipadatkan di tempat
+			if (HasHeld()) {
+				size_t keep = g_held_head_ ;
+				for (size_t i = g_held_head_; i < g_held_.size(); ++i) {
+					if (n < out.size() && (filter & FilterOf(g_held_[i].GetEventType()))) {
+						out[n++] = g_held_[i] ;
+					} else {
+						g_held_[keep++] = g_held_[i] ;
+					}
+				}
+				g_held_.resize(keep) ;
+				if (!HasHeld()) {
+					g_held_.clear() ;
+					g_held_head_ = 0 ;
+				}
+			}
+
+			while (n < out.size()) {
+				size_t end = n + g_events_.TryPopBulk(out.data() + n, out.size() - n) ;
+				if (end == n) {
+					break ;
+				}
+
+				if (filter == EventFilterAll) {
+					n = end ;
+					continue ;
+				}
+
+				for (size_t i = n; i < end; ++i) {
+					if (filter & FilterOf(out[i].GetEventType())) {
+						out[n++] = out[i] ;
+					} else {
+						Hold(out[i]) ;
+					}
+				}
+
+				if (g_held_.size() - g_held_head_ >= QueueCapacity) {
+					break ;
+				}
+			}
+
+			if (g_observer_) {
+				for (size_t i = 0; i < n; ++i) {
+					Observe(out[i]) ;
+				}
+			}
+			return n ;
+		}
+
+		// aman dipanggil dari thread mana pun, mengikuti overflow policy. return jumlah
+		// event yang masuk antrian, selalu prefix dari events (sisanya dibuang bila Reject)
+		static size_t PushEvents(std::span<const Event> events) noexcept {
+			size_t pushed = g_events_.PushBulk(events.data(), events.size()) ;
+
+			#ifdef EVENTSYSTEM_DEBUG
+				if (pushed < events.size()) {
+					logger::warning("EventSystem::PushEvents - Queue full, events dropped.") ;
+				}
+			#endif
+
+			return pushed ;
+		}
+
+		static size_t PostEvents(std::span<const Event> events) noexcept {
+			size_t pushed = PushEvents(events) ;
+			if (pushed > 0) {
+				Wake() ;
+			}
+			return pushed ;
+		}
+
 		static bool PeekEvent(Event& e) noexcept {
-			if (g_events_.empty()) {
-				return false ;
+			if (!HasHeld()) {
+				Event next ;
+				if (!g_events_.TryPop(next)) {
+					return false ;
+				}
+				Hold(next) ;
+				if (!HasHeld()) {
+					return false ;
+				}
 			}
 
-			e = g_events_.front() ;
+			e = g_held_[g_held_head_] ;
 			return true ;
 		}
 
 		static void Clear() noexcept {
-			while (!g_events_.empty()) {
-				g_events_.pop() ;
-			}
+			g_events_.Clear() ;
+			g_held_.clear() ;
+			g_held_head_ = 0 ;
+			g_samples_.clear() ;
 
 			#ifdef EVENTSYSTEM_DEBUG
 				logger::info("EventSystem::Clear - Event cleared!") ;
@@ -404,23 +782,26 @@ namespace zketch {
 		return "Undefined" ;
 	}
 
-	inline bool PollEvent(Event& e) {
-		if (EventSystem::PollEvent(e)) {
-			return true ;
-		}
+#ifdef ZKETCH_WIN32
+	// kosongkan antrian pesan Win32 ke EventSystem, berhenti di WM_QUIT (quit = true).
+	// return jumlah pesan yang diproses.
+	inline size_t PumpMessages(bool& quit) {
+		quit = false ;
+		size_t count = 0 ;
 
 		MSG msg{};
 		while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
 			if (msg.message == WM_QUIT) {
 				
 				#ifdef POLLEVENT_DEBUG
-					logger::info("PollEvent - WM_QUIT received via PeekMessage.") ;
+					logger::info("PumpMessages - WM_QUIT received via PeekMessage.") ;
 				#endif
 
-				e = Event::CreateCommonEvent(nullptr, EventType::Quit) ;
-				return true ;
+				quit = true ;
+				return count ;
 			}
 
+			++count ;
 			Event ecvt = Event::CreateEventFromMSG(msg) ;
 
 			if (ecvt != EventType::None) {
@@ -431,7 +812,93 @@ namespace zketch {
 			DispatchMessage(&msg) ;
 		}
 
+		return count ;
+	}
+
+	inline bool PollEvent(Event& e) {
+		if (EventSystem::PollEvent(e)) {
+			return true ;
+		}
+
+		bool quit ;
+		PumpMessages(quit) ;
+		if (quit) {
+			e = Event::CreateCommonEvent(nullptr, EventType::Quit) ;
+			return true ;
+		}
+
+		return EventSystem::PollEvent(e) ;
+	}
+
+	// versi burst dari PollEvent. WM_QUIT masuk antrian sebagai event Quit supaya urutannya terjaga
+	inline size_t PollEvents(std::span<Event> out, EventFilter filter = EventFilterAll) {
+		size_t n = EventSystem::PollEvents(out, filter) ;
+		if (n == out.size()) {
+			return n ;
+		}
+
+		bool quit ;
+		PumpMessages(quit) ;
+		if (quit) {
+			EventSystem::PushEvent(Event::CreateCommonEvent(nullptr, EventType::Quit)) ;
+		}
+
+		return n + EventSystem::PollEvents(out.subspan(n), filter) ;
+	}
+#else
+	// tanpa antrian pesan OS : hanya event dari PushEvent / PostEvent
+	inline bool PollEvent(Event& e) {
 		return EventSystem::PollEvent(e) ;
 	}
 
+	inline size_t PollEvents(std::span<Event> out, EventFilter filter = EventFilterAll) {
+		return EventSystem::PollEvents(out, filter) ;
+	}
+#endif
+
+	// seperti PollEvent, tapi tidur di MsgWaitForMultipleObjects sampai ada pesan OS,
+	// PostEvent dari thread lain, deadline ScheduleWake atau timeout_ms habis.
+	// di luar Win32 tidur di condition variable WakeSignal (tanpa pesan OS).
+	// false bila tidak ada event sampai batas waktu.
+	inline bool WaitEvent(Event& e, uint32_t timeout_ms = WaitInfinite) {
+		using Clock = std::chrono::steady_clock ;
+		Clock::time_point deadline = timeout_ms == WaitInfinite ? Clock::time_point::max() : Clock::now() + std::chrono::milliseconds(timeout_ms) ;
+
+		#ifdef ZKETCH_WIN32
+			HANDLE wake = EventSystem::GetWakeHandle() ;
+		#endif
+
+		for (;;) {
+			if (PollEvent(e)) {
+				return true ;
+			}
+
+			Clock::time_point now = Clock::now() ;
+			Clock::time_point until = std::min(deadline, EventSystem::GetScheduledWake()) ;
+			if (now >= until) {
+				if (until == EventSystem::GetScheduledWake()) {
+					EventSystem::ClearScheduledWake() ;
+				}
+				return false ;
+			}
+
+			#ifdef ZKETCH_WIN32
+				DWORD wait = INFINITE ;
+				if (until != Clock::time_point::max()) {
+					auto ms = std::chrono::ceil<std::chrono::milliseconds>(until - now).count() ;
+					wait = static_cast<DWORD>(std::min<int64_t>(ms, INFINITE - 1)) ;
+				}
+
+				// MWMO_INPUTAVAILABLE : pesan yang sudah terlihat PeekMessage tetap membangunkan
+				MsgWaitForMultipleObjectsEx(wake ? 1 : 0, wake ? &wake : nullptr, wait, QS_ALLINPUT, MWMO_INPUTAVAILABLE) ;
+			#else
+				EventSystem::GetWakeSignal().WaitUntil(until) ;
+			#endif
+		}
+	}
+
+	inline bool PollEvent(Event& e, WaitMode mode) {
+		return mode == WaitMode::Block ? WaitEvent(e) : PollEvent(e) ;
+	}
+
 }
\ No newline at end of file
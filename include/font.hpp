@@ -56,8 +56,10 @@ namespace zketch {
 		const std::wstring_view& GetFontName() const noexcept { return name_ ; }
 		FontStyle GetFontStyle() const noexcept { return static_cast<FontStyle>(style_) ; }
 
+	#ifdef ZKETCH_WIN32
 		operator Gdiplus::Font() const noexcept { 
 			return Gdiplus::Font(name_.data(), GetFontSize(), style_, Gdiplus::UnitPixel) ; 
 		}
+	#endif
 	} ;
 }
\ No newline at end of file
@@ -0,0 +1,355 @@
+#pragma once
+#include "font.hpp"
+#include "lrucache.hpp"
+
+namespace zketch {
+
+	// tabel advance glyph untuk satu font. ASCII disimpan di array, karakter lain di map
+	// dan diisi lazy lewat resolver. pengukuran murni aritmatika tanpa panggilan native,
+	// jadi bisa diisi metrics sintetis untuk headless / pengujian.
+	class GlyphMetrics {
+	public :
+		// resolver(c, advance) -> false bila glyph tidak diketahui
+		using Resolver = std::function<bool(wchar_t, float&)> ;
+
+		static constexpr uint32_t AsciiCount = 128 ;
+
+	private :
+		mutable std::array<float, AsciiCount> ascii_ ;
+		mutable std::unordered_map<uint32_t, float> extended_ ;
+		std::unordered_map<uint64_t, float> kerning_ ;
+		Resolver resolver_ {} ;
+		std::wstring name_ ;
+		float default_advance_ = 0.0f ;
+		float line_height_ = 0.0f ;
+		float ascent_ = 0.0f ;
+		float padding_ = 0.0f ;
+
+		static constexpr uint64_t PairKey(wchar_t first, wchar_t second) noexcept {
+			return (static_cast<uint64_t>(static_cast<uint32_t>(first)) << 32) | static_cast<uint32_t>(second) ;
+		}
+
+	public :
+		GlyphMetrics() noexcept {
+			ascii_.fill(-1.0f) ;
+		}
+
+		// metrics kasar dari ukuran font, dipakai saat tidak ada font native (headless)
+		static GlyphMetrics Approximate(const Font& font) noexcept {
+			GlyphMetrics m ;
+			float size = std::max(font.GetFontSize(), 0.0f) ;
+			m.name_ = font.GetFontName() ;
+			m.default_advance_ = size * 0.5f ;
+			m.line_height_ = size * 1.2f ;
+			m.ascent_ = size * 0.9f ;
+			m.ascii_[L' '] = size * 0.25f ;
+			return m ;
+		}
+
+		float Advance(wchar_t c) const noexcept {
+			uint32_t code = static_cast<uint32_t>(c) ;
+			if (code < AsciiCount && ascii_[code] >= 0.0f) {
+				return ascii_[code] ;
+			}
+
+			if (code >= AsciiCount) {
+				auto it = extended_.find(code) ;
+				if (it != extended_.end()) {
+					return it->second ;
+				}
+			}
+
+			// glyph yang tidak dikenal resolver tetap disimpan supaya tidak ditanya ulang
+			float advance = default_advance_ ;
+			if (resolver_ && !resolver_(c, advance)) {
+				advance = default_advance_ ;
+			}
+
+			if (code < AsciiCount) {
+				ascii_[code] = advance ;
+			} else {
+				extended_.emplace(code, advance) ;
+			}
+			return advance ;
+		}
+
+		float Kerning(wchar_t first, wchar_t second) const noexcept {
+			if (kerning_.empty()) {
+				return 0.0f ;
+			}
+
+			auto it = kerning_.find(PairKey(first, second)) ;
+			return it != kerning_.end() ? it->second : 0.0f ;
+		}
+
+		// lebar baris terpanjang, '\n' memulai baris baru. padding dihitung sekali
+		// seperti layout box MeasureString GDI+.
+		float Measure(std::wstring_view text) const noexcept {
+			if (text.empty()) {
+				return 0.0f ;
+			}
+
+			float line = 0.0f ;
+			float widest = 0.0f ;
+			wchar_t prev = 0 ;
+			for (wchar_t c : text) {
+				if (c == L'\n') {
+					widest = std::max(widest, line) ;
+					line = 0.0f ;
+					prev = 0 ;
+					continue ;
+				}
+
+				if (c == L'\r') {
+					continue ;
+				}
+
+				line += Advance(c) ;
+				if (prev) {
+					line += Kerning(prev, c) ;
+				}
+				prev = c ;
+			}
+
+			return std::max(widest, line) + padding_ ;
+		}
+
+		uint32_t CountLines(std::wstring_view text) const noexcept {
+			return 1 + static_cast<uint32_t>(std::count(text.begin(), text.end(), L'\n')) ;
+		}
+
+		// teks kosong tetap setinggi satu baris supaya caret punya tinggi
+		RectF Bound(std::wstring_view text, const PointF& origin = {}) const noexcept {
+			return {origin.x, origin.y, Measure(text), line_height_ * static_cast<float>(CountLines(text))} ;
+		}
+
+		void SetAdvance(wchar_t c, float advance) noexcept {
+			uint32_t code = static_cast<uint32_t>(c) ;
+			if (code < AsciiCount) {
+				ascii_[code] = advance ;
+			} else {
+				extended_[code] = advance ;
+			}
+		}
+
+		void SetKerning(wchar_t first, wchar_t second, float adjust) noexcept {
+			if (adjust == 0.0f) {
+				kerning_.erase(PairKey(first, second)) ;
+				return ;
+			}
+			kerning_[PairKey(first, second)] = adjust ;
+		}
+
+		void SetLineMetrics(float line_height, float ascent) noexcept {
+			line_height_ = line_height ;
+			ascent_ = ascent ;
+		}
+
+		void SetName(std::wstring_view name) { name_ = name ; }
+		void SetResolver(Resolver resolver) noexcept { resolver_ = std::move(resolver) ; }
+		void SetDefaultAdvance(float advance) noexcept { default_advance_ = advance ; }
+		void SetPadding(float padding) noexcept { padding_ = padding ; }
+
+		const std::wstring& GetName() const noexcept { return name_ ; }
+		float GetLineHeight() const noexcept { return line_height_ ; }
+		float GetAscent() const noexcept { return ascent_ ; }
+		float GetPadding() const noexcept { return padding_ ; }
+		float GetDefaultAdvance() const noexcept { return default_advance_ ; }
+		size_t GetKerningCount() const noexcept { return kerning_.size() ; }
+	} ;
+
+	struct FontKey {
+		uint64_t name_ = 0 ; // hash nama, nama asli dicek ulang di GlyphMetrics
+		float size_ = 0.0f ;
+		uint8_t style_ = 0 ;
+
+		static FontKey From(const Font& font) noexcept {
+			uint64_t h = 14695981039346656037ull ;
+			for (wchar_t c : font.GetFontName()) {
+				h ^= static_cast<uint32_t>(c) ;
+				h *= 1099511628211ull ;
+			}
+			return {h, font.GetFontSize(), static_cast<uint8_t>(font.GetFontStyle())} ;
+		}
+
+		constexpr bool operator==(const FontKey& o) const noexcept {
+			return name_ == o.name_ && size_ == o.size_ && style_ == o.style_ ;
+		}
+	} ;
+
+	struct FontKeyHash {
+		size_t operator()(const FontKey& k) const noexcept {
+			uint32_t bits ;
+			std::memcpy(&bits, &k.size_, sizeof(bits)) ;
+			uint64_t h = k.name_ ^ (static_cast<uint64_t>(bits) * 0x9E3779B1u) ^ k.style_ ;
+			h ^= h >> 29 ;
+			h *= 0xBF58476D1CE4E5B9ull ;
+			h ^= h >> 32 ;
+			return static_cast<size_t>(h) ;
+		}
+	} ;
+
+	// GlyphMetrics per font, dibangun sekali lalu dipakai ulang semua pengukuran teks.
+	// per thread seperti PaintCache. di Win32 tabel diisi dari GDI, selain itu Approximate.
+	class FontMetricsCache {
+	private :
+		LruCache<FontKey, std::unique_ptr<GlyphMetrics>, FontKeyHash> fonts_ ;
+
+	#ifdef ZKETCH_WIN32
+		// DC memori + HFONT yang tetap hidup selama tabel dipakai, untuk glyph non-ASCII
+		struct NativeFont {
+			HDC dc_ = nullptr ;
+			HFONT font_ = nullptr ;
+			HGDIOBJ old_ = nullptr ;
+			float scale_ = 1.0f ;
+
+			NativeFont(const NativeFont&) = delete ;
+			NativeFont& operator=(const NativeFont&) = delete ;
+
+			NativeFont(const Font& font) noexcept {
+				int px = std::max(1, static_cast<int>(std::lround(font.GetFontSize()))) ;
+				scale_ = font.GetFontSize() / static_cast<float>(px) ;
+
+				dc_ = CreateCompatibleDC(nullptr) ;
+				if (!dc_) {
+					return ;
+				}
+
+				// lfHeight negatif = tinggi em dalam pixel, sama dengan Gdiplus::UnitPixel
+				uint8_t style = static_cast<uint8_t>(font.GetFontStyle()) ;
+				std::wstring name(font.GetFontName()) ;
+				font_ = CreateFontW(-px, 0, 0, 0, (style & 1) ? FW_BOLD : FW_NORMAL, (style & 2) ? TRUE : FALSE, FALSE, FALSE,
+					DEFAULT_CHARSET, OUT_TT_PRECIS, CLIP_DEFAULT_PRECIS, ANTIALIASED_QUALITY, DEFAULT_PITCH | FF_DONTCARE, name.c_str()) ;
+				if (font_) {
+					old_ = SelectObject(dc_, font_) ;
+				}
+			}
+
+			~NativeFont() noexcept {
+				if (dc_) {
+					if (old_) {
+						SelectObject(dc_, old_) ;
+					}
+					DeleteDC(dc_) ;
+				}
+				if (font_) {
+					DeleteObject(font_) ;
+				}
+			}
+
+			bool IsValid() const noexcept { return dc_ && font_ ; }
+
+			bool Advance(wchar_t c, float& out) const noexcept {
+				ABCFLOAT abc ;
+				if (!GetCharABCWidthsFloatW(dc_, c, c, &abc)) {
+					return false ;
+				}
+				out = (abc.abcfA + abc.abcfB + abc.abcfC) * scale_ ;
+				return true ;
+			}
+		} ;
+
+		static std::unique_ptr<GlyphMetrics> Build(const Font& font) noexcept {
+			auto metrics = std::make_unique<GlyphMetrics>(GlyphMetrics::Approximate(font)) ;
+
+			auto native = std::make_shared<NativeFont>(font) ;
+			if (!native->IsValid()) {
+
+				#ifdef FONT_DEBUG
+					logger::wwarning(L"FontMetricsCache::Build - Native font unavailable, using approximate metrics : ", font.GetFontName()) ;
+				#endif
+
+				return metrics ;
+			}
+
+			float scale = native->scale_ ;
+
+			ABCFLOAT abc[GlyphMetrics::AsciiCount - 32] ;
+			if (GetCharABCWidthsFloatW(native->dc_, 32, GlyphMetrics::AsciiCount - 1, abc)) {
+				for (uint32_t i = 0; i < GlyphMetrics::AsciiCount - 32; ++i) {
+					metrics->SetAdvance(static_cast<wchar_t>(32 + i), (abc[i].abcfA + abc[i].abcfB + abc[i].abcfC) * scale) ;
+				}
+			}
+
+			DWORD pairs = GetKerningPairsW(native->dc_, 0, nullptr) ;
+			if (pairs > 0) {
+				std::vector<KERNINGPAIR> kerning(pairs) ;
+				pairs = GetKerningPairsW(native->dc_, pairs, kerning.data()) ;
+				for (DWORD i = 0; i < pairs; ++i) {
+					metrics->SetKerning(static_cast<wchar_t>(kerning[i].wFirst), static_cast<wchar_t>(kerning[i].wSecond), static_cast<float>(kerning[i].iKernAmount) * scale) ;
+				}
+			}
+
+			TEXTMETRICW tm ;
+			if (GetTextMetricsW(native->dc_, &tm)) {
+				metrics->SetLineMetrics(static_cast<float>(tm.tmHeight + tm.tmExternalLeading) * scale, static_cast<float>(tm.tmAscent) * scale) ;
+				metrics->SetDefaultAdvance(static_cast<float>(tm.tmAveCharWidth) * scale) ;
+			}
+
+			// kalibrasi sekali dengan MeasureString supaya padding dan tinggi baris
+			// sama dengan layout GDI+ yang dipakai DrawString
+			{
+				Gdiplus::Graphics g(native->dc_) ;
+				Gdiplus::Font used_font = font ;
+				Gdiplus::RectF res ;
+				if (g.GetLastStatus() == Gdiplus::Ok && g.MeasureString(L"x", 1, &used_font, Gdiplus::PointF(0.0f, 0.0f), &res) == Gdiplus::Ok) {
+					metrics->SetPadding(std::max(res.Width - metrics->Advance(L'x'), 0.0f)) ;
+					metrics->SetLineMetrics(res.Height, metrics->GetAscent()) ;
+				} else {
+					metrics->SetPadding(font.GetFontSize() / 3.0f) ;
+				}
+			}
+
+			metrics->SetResolver([native](wchar_t c, float& out) {
+				return native->Advance(c, out) ;
+			}) ;
+
+			return metrics ;
+		}
+	#else
+		static std::unique_ptr<GlyphMetrics> Build(const Font& font) noexcept {
+			return std::make_unique<GlyphMetrics>(GlyphMetrics::Approximate(font)) ;
+		}
+	#endif
+
+	public :
+		static constexpr size_t DefaultCapacity = 32 ;
+
+		explicit FontMetricsCache(size_t capacity = DefaultCapacity) noexcept : fonts_(capacity) {}
+
+		static FontMetricsCache& ForThread() noexcept {
+			static thread_local FontMetricsCache cache ;
+			return cache ;
+		}
+
+		const GlyphMetrics& Get(const Font& font) noexcept {
+			auto& metrics = fonts_.GetOrCreate(FontKey::From(font), [&] {
+				return Build(font) ;
+			}) ;
+
+			// tabrakan hash nama : bangun ulang untuk font yang diminta
+			if (metrics->GetName() != font.GetFontName()) {
+				metrics = Build(font) ;
+			}
+			return *metrics ;
+		}
+
+		// pasang metrics sendiri untuk font ini (mis. metrics sintetis). seperti entry lain
+		// bisa tergusur LRU, setelah itu dibangun ulang dari font native.
+		void Register(const Font& font, GlyphMetrics metrics) noexcept {
+			metrics.SetName(font.GetFontName()) ;
+			auto& slot = fonts_.GetOrCreate(FontKey::From(font), [] {
+				return std::unique_ptr<GlyphMetrics> {} ;
+			}) ;
+			slot = std::make_unique<GlyphMetrics>(std::move(metrics)) ;
+		}
+
+		void SetCapacity(size_t capacity) noexcept { fonts_.SetCapacity(capacity) ; }
+		void Clear() noexcept { fonts_.Clear() ; }
+		void ResetStats() noexcept { fonts_.ResetStats() ; }
+
+		size_t GetSize() const noexcept { return fonts_.GetSize() ; }
+		uint64_t GetHits() const noexcept { return fonts_.GetHits() ; }
+		uint64_t GetMisses() const noexcept { return fonts_.GetMisses() ; }
+	} ;
+}
\ No newline at end of file
@@ -0,0 +1,131 @@
+#pragma once
+#include "logger.hpp"
+
+namespace zketch {
+
+	// histogram durasi dalam ms, Buckets bucket selebar WidthUs mikrodetik. nilai di atas
+	// bucket terakhir masuk bucket overflow, percentile-nya memakai nilai max.
+	template <uint32_t Buckets, uint32_t WidthUs>
+	class BasicHistogram {
+	public :
+		static constexpr uint32_t BucketCount = Buckets ;
+		static constexpr double BucketWidth = WidthUs / 1000.0 ;
+
+	private :
+		std::array<uint32_t, BucketCount> buckets_ {} ;
+		uint64_t count_ = 0 ;
+		double sum_ = 0.0 ;
+		double sum_sq_ = 0.0 ;
+		double min_ = 0.0 ;
+		double max_ = 0.0 ;
+
+	public :
+		void Record(double ms) noexcept {
+			ms = std::max(ms, 0.0) ;
+			uint32_t index = static_cast<uint32_t>(std::min(ms / BucketWidth, static_cast<double>(BucketCount - 1))) ;
+			++buckets_[index] ;
+
+			min_ = count_ ? std::min(min_, ms) : ms ;
+			max_ = count_ ? std::max(max_, ms) : ms ;
+			++count_ ;
+			sum_ += ms ;
+			sum_sq_ += ms * ms ;
+		}
+
+		void Reset() noexcept {
+			*this = BasicHistogram{} ;
+		}
+
+		// batas atas bucket tempat percentile p (0 .. 1) jatuh
+		double Percentile(double p) const noexcept {
+			if (count_ == 0) {
+				return 0.0 ;
+			}
+
+			uint64_t rank = static_cast<uint64_t>(std::ceil(std::clamp(p, 0.0, 1.0) * static_cast<double>(count_))) ;
+			rank = std::max<uint64_t>(rank, 1) ;
+
+			uint64_t seen = 0 ;
+			for (uint32_t i = 0; i < BucketCount - 1; ++i) {
+				seen += buckets_[i] ;
+				if (seen >= rank) {
+					return std::min(static_cast<double>(i + 1) * BucketWidth, max_) ;
+				}
+			}
+			return max_ ;
+		}
+
+		double GetMean() const noexcept { return count_ ? sum_ / static_cast<double>(count_) : 0.0 ; }
+
+		double GetStdDev() const noexcept {
+			if (count_ < 2) {
+				return 0.0 ;
+			}
+
+			double mean = GetMean() ;
+			return std::sqrt(std::max(sum_sq_ / static_cast<double>(count_) - mean * mean, 0.0)) ;
+		}
+
+		uint64_t GetCount() const noexcept { return count_ ; }
+		double GetMin() const noexcept { return min_ ; }
+		double GetMax() const noexcept { return max_ ; }
+		const std::array<uint32_t, BucketCount>& GetBuckets() const noexcept { return buckets_ ; }
+	} ;
+
+	// waktu frame : 0 .. 32 ms per 0.25 ms
+	using FrameHistogram = BasicHistogram<128, 250> ;
+
+	// deadline frame dengan interval tetap. deadline yang sudah terlewat tidak dikejar
+	// satu per satu tapi dilompati (dihitung sebagai frame skip), jadi fase frame tetap.
+	class FramePacer {
+	public :
+		using Clock = std::chrono::steady_clock ;
+
+	private :
+		Clock::duration interval_ {} ;
+		Clock::time_point deadline_ {} ;
+		uint64_t skipped_ = 0 ;
+		bool started_ = false ;
+
+	public :
+		explicit FramePacer(double fps = 60.0) noexcept {
+			SetFrameRate(fps) ;
+		}
+
+		void SetFrameRate(double fps) noexcept {
+			fps = std::clamp(fps, 1.0, 1000.0) ;
+			interval_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps)) ;
+		}
+
+		// frame yang dimulai pada now sudah dijalankan, kembalikan deadline berikutnya
+		Clock::time_point Advance(Clock::time_point now) noexcept {
+			if (!started_) {
+				started_ = true ;
+				deadline_ = now + interval_ ;
+				return deadline_ ;
+			}
+
+			deadline_ += interval_ ;
+			if (deadline_ <= now) {
+				auto behind = (now - deadline_) / interval_ + 1 ;
+				skipped_ += static_cast<uint64_t>(behind) ;
+				deadline_ += behind * interval_ ;
+			}
+			return deadline_ ;
+		}
+
+		// setelah idle, frame berikutnya langsung jatuh tempo dan fase dimulai ulang
+		void Reset() noexcept { started_ = false ; }
+
+		bool IsDue(Clock::time_point now) const noexcept { return !started_ || now >= deadline_ ; }
+		bool IsStarted() const noexcept { return started_ ; }
+
+		Clock::duration GetRemaining(Clock::time_point now) const noexcept {
+			return IsDue(now) ? Clock::duration::zero() : deadline_ - now ;
+		}
+
+		Clock::time_point GetDeadline() const noexcept { return deadline_ ; }
+		Clock::duration GetInterval() const noexcept { return interval_ ; }
+		uint64_t GetSkipped() const noexcept { return skipped_ ; }
+	} ;
+}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#ifdef ZKETCH_WIN32
+
 #include <objidl.h>
 #include <gdiplus.h>
 
@@ -21,4 +23,6 @@ namespace zketch {
 	} ;
 
 	static GDISession__ gdi_session_init__ ;
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+#include "unit.hpp"
+#include "lrucache.hpp"
+
+namespace zketch {
+
+	struct RoundedRectKey {
+		float w_ = 0.0f ;
+		float h_ = 0.0f ;
+		float radius_ = 0.0f ;
+		float thickness_ = 0.0f ;
+
+		constexpr bool operator==(const RoundedRectKey& o) const noexcept {
+			return w_ == o.w_ && h_ == o.h_ && radius_ == o.radius_ && thickness_ == o.thickness_ ;
+		}
+	} ;
+
+	struct RoundedRectKeyHash {
+		size_t operator()(const RoundedRectKey& k) const noexcept {
+			// + 0.0f : -0.0f jadi +0.0f, sama dengan operator==
+			const float f[4] = {k.w_ + 0.0f, k.h_ + 0.0f, k.radius_ + 0.0f, k.thickness_ + 0.0f} ;
+			uint32_t v[4] ;
+			std::memcpy(v, f, sizeof(v)) ;
+			uint64_t h = 1469598103934665603ull ;
+			for (uint32_t x : v) {
+				h = (h ^ x) * 0x100000001B3ull ;
+			}
+			return static_cast<size_t>(h ^ (h >> 31)) ;
+		}
+	} ;
+
+	// segmen per seperempat lingkaran supaya jarak chord ke busur <= tolerance
+	inline uint32_t ArcSegments(float radius, float tolerance = 0.25f) noexcept {
+		if (radius <= tolerance) {
+			return 1 ;
+		}
+
+		float step = 2.0f * std::acos(1.0f - tolerance / radius) ;
+		uint32_t n = static_cast<uint32_t>(std::ceil(1.57079632679f / step)) ;
+		return std::clamp<uint32_t>(n, 1, 64) ;
+	}
+
+	// outline rounded rect di origin (0, 0, w, h), searah jarum jam mulai sudut kiri atas.
+	// radius di-clamp ke min(w, h) / 2. thickness hanya mempengaruhi jumlah segmen
+	// karena tepi luar stroke berada di radius + thickness / 2.
+	inline void FlattenRoundedRect(float w, float h, float radius, float thickness, Vertex& out, float tolerance = 0.25f) noexcept {
+		out.clear() ;
+		if (w <= 0.0f || h <= 0.0f) {
+			return ;
+		}
+
+		radius = std::clamp(radius, 0.0f, std::min(w, h) * 0.5f) ;
+		if (radius <= 0.0f) {
+			out.assign({{0.0f, 0.0f}, {w, 0.0f}, {w, h}, {0.0f, h}}) ;
+			return ;
+		}
+
+		uint32_t n = ArcSegments(radius + std::max(thickness, 0.0f) * 0.5f, tolerance) ;
+		out.reserve(4 * (n + 1)) ;
+
+		// pusat busur dan sudut awal, y ke bawah jadi 180 -> 270 adalah kiri atas
+		const PointF centers[4] = {
+			{radius, radius},
+			{w - radius, radius},
+			{w - radius, h - radius},
+			{radius, h - radius}
+		} ;
+
+		constexpr float half_pi = 1.57079632679f ;
+		for (uint32_t c = 0; c < 4; ++c) {
+			float start = half_pi * static_cast<float>(c + 2) ;
+			for (uint32_t i = 0; i <= n; ++i) {
+				float a = start + half_pi * static_cast<float>(i) / static_cast<float>(n) ;
+				out.emplace_back(centers[c].x + std::cos(a) * radius, centers[c].y + std::sin(a) * radius) ;
+			}
+		}
+	}
+
+	// outline rounded rect yang sudah di-flatten, dipakai ulang lintas draw lalu
+	// digeser ke posisi tujuan. per thread seperti PaintCache.
+	class GeometryCache {
+	private :
+		LruCache<RoundedRectKey, Vertex, RoundedRectKeyHash> rounded_ ;
+
+	public :
+		static constexpr size_t DefaultCapacity = 128 ;
+
+		explicit GeometryCache(size_t capacity = DefaultCapacity) noexcept : rounded_(capacity) {}
+
+		static GeometryCache& ForThread() noexcept {
+			static thread_local GeometryCache cache ;
+			return cache ;
+		}
+
+		// input non-finite (NaN tidak pernah sama dengan dirinya, jadi tidak bisa jadi key)
+		// menghasilkan outline kosong tanpa menyentuh cache
+		const Vertex& GetRoundedRect(float w, float h, float radius, float thickness = 0.0f) noexcept {
+			if (!std::isfinite(w) || !std::isfinite(h) || !std::isfinite(radius) || !std::isfinite(thickness)) {
+				static const Vertex empty {} ;
+				return empty ;
+			}
+
+			RoundedRectKey key {w, h, radius, thickness} ;
+			return rounded_.GetOrCreate(key, [&] {
+				Vertex outline ;
+				FlattenRoundedRect(w, h, radius, thickness, outline) ;
+				return outline ;
+			}) ;
+		}
+
+		void SetCapacity(size_t capacity) noexcept { rounded_.SetCapacity(capacity) ; }
+		void Clear() noexcept { rounded_.Clear() ; }
+		void ResetStats() noexcept { rounded_.ResetStats() ; }
+
+		size_t GetSize() const noexcept { return rounded_.GetSize() ; }
+		uint64_t GetHits() const noexcept { return rounded_.GetHits() ; }
+		uint64_t GetMisses() const noexcept { return rounded_.GetMisses() ; }
+	} ;
+}
\ No newline at end of file
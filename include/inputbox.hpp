@@ -16,6 +16,7 @@ namespace zketch {
 		size_t cursor_index_ = 0 ;
 		PointF text_offset_ = {} ;
 		std::wstring text_ ;
+		std::vector<float> prefix_ {0.0f} ; // prefix_[i] = lebar text_[0, i) tanpa padding
 		Font font_ ;
 		std::function<void(Canvas*, const InputBox&)> drawing_logic_ ;
 		std::function<void()> callback_ ;
@@ -32,15 +33,59 @@ namespace zketch {
 			drawing_logic_(canvas_.get(), *this) ;
 		}
 
+		const GlyphMetrics& Metrics() const noexcept {
+			return FontMetricsCache::ForThread().Get(font_) ;
+		}
+
+		// advance karakter i plus kerning dengan karakter sebelumnya
+		float GlyphWidth(const GlyphMetrics& metrics, size_t i) const noexcept {
+			float w = metrics.Advance(text_[i]) ;
+			if (i > 0) {
+				w += metrics.Kerning(text_[i - 1], text_[i]) ;
+			}
+			return w ;
+		}
+
+		void RebuildPrefix() noexcept {
+			const GlyphMetrics& metrics = Metrics() ;
+			prefix_.resize(text_.size() + 1) ;
+			prefix_[0] = 0.0f ;
+			for (size_t i = 0; i < text_.size(); ++i) {
+				prefix_[i + 1] = prefix_[i] + GlyphWidth(metrics, i) ;
+			}
+		}
+
+		// prefix_[from ..] masih nilai lama yang bergeser konstan, cukup hitung ulang
+		// satu entry lalu tambahkan selisihnya ke sisanya (kerning pasangan baru ikut)
+		void ShiftPrefix(const GlyphMetrics& metrics, size_t from) noexcept {
+			if (from >= prefix_.size()) {
+				return ;
+			}
+
+			float delta = prefix_[from - 1] + GlyphWidth(metrics, from - 1) - prefix_[from] ;
+			for (size_t i = from; i < prefix_.size(); ++i) {
+				prefix_[i] += delta ;
+			}
+		}
+
+		void InsertPrefix(size_t index) noexcept {
+			const GlyphMetrics& metrics = Metrics() ;
+			prefix_.insert(prefix_.begin() + index + 1, prefix_[index] + GlyphWidth(metrics, index)) ;
+			ShiftPrefix(metrics, index + 2) ;
+		}
+
+		void ErasePrefix(size_t index) noexcept {
+			prefix_.erase(prefix_.begin() + index + 1) ;
+			ShiftPrefix(Metrics(), index + 1) ;
+		}
+
 		void AutoScrollToCursor() noexcept {
 			if (text_.empty() || cursor_index_ == 0) {
 				text_offset_.x = 0 ;
 				return ;
 			}
 
-			std::wstring before_cursor = text_.substr(0, cursor_index_) ;
-			RectF layout = Renderer::GetStringBound(font_, before_cursor) ;
-			float cursor_x = layout.w ;
+			float cursor_x = GetCaretOffset(cursor_index_) ;
 			float visible_width = bound_.w - 20.0f ; 
 
 			if (cursor_x + text_offset_.x > visible_width) {
@@ -64,7 +109,7 @@ namespace zketch {
 			cursor_interval_ = cursor_interval_ms ;
 			cursor_index_ = 0 ;
 			font_ = font ;
-			canvas_->Create(bound_.GetSize()) ;
+			CreateSurface(*canvas_, bound_.GetSize()) ;
 
 			SetDrawingLogic([](Canvas* canvas, const InputBox& input){
 				Renderer render ;
@@ -102,11 +147,11 @@ namespace zketch {
 					2.0f
 				) ;
 
-				RectF layout = Renderer::GetStringBound(input.GetFont(), input.GetText()) ;
+				float line_height = input.GetLineHeight() ;
 				if (!input.GetText().empty()) {
 					Point text_pos = {
 						static_cast<int32_t>(input.GetTextOffset().x + 10), 
-						static_cast<int32_t>(input.GetRelativeBound().h / 2 - layout.h / 2)
+						static_cast<int32_t>(input.GetRelativeBound().h / 2 - line_height / 2)
 					} ;
 
 					render.DrawString(
@@ -118,7 +163,7 @@ namespace zketch {
 				} else if (input.GetText().empty() && !input.IsActive()) {
 					Point placeholder_pos = {
 						static_cast<int32_t>(input.GetTextOffset().x + 10), 
-						static_cast<int32_t>(input.GetRelativeBound().h / 2 - layout.h / 2)
+						static_cast<int32_t>(input.GetRelativeBound().h / 2 - line_height / 2)
 					} ;
 
 					render.DrawString(
@@ -130,16 +175,9 @@ namespace zketch {
 				}
                 
                 if (input.IsActive() && input.IsCursorVisible()) {
-					float cursor_x = input.GetTextOffset().x + 10 ;
-					
-					if (input.GetCursorIndex() > 0 && input.GetCursorIndex() <= input.GetText().size()) {
-						std::wstring before_cursor = input.GetText().substr(0, input.GetCursorIndex()) ;
-						layout = Renderer::GetStringBound(input.GetFont(), before_cursor) ;
-						cursor_x += layout.w ;
-					}
-					
-					float cursor_y = input.GetRelativeBound().h / 2 - layout.h / 2 ;
-					float cursor_height = layout.h ;
+					float cursor_x = input.GetTextOffset().x + 10 + input.GetCaretOffset(input.GetCursorIndex()) ;
+					float cursor_y = input.GetRelativeBound().h / 2 - line_height / 2 ;
+					float cursor_height = line_height ;
 					
 					render.DrawLine(
 						{static_cast<int32_t>(cursor_x), static_cast<int32_t>(cursor_y)},
@@ -161,7 +199,7 @@ namespace zketch {
             bool state = bound_.Contain(mouse_pos) ;
             if (state != is_hovered_) {
                 is_hovered_ = state ;
-                update_ = true ;
+                MarkDirty() ;
             }
             return state ;
 		}
@@ -173,35 +211,12 @@ namespace zketch {
 				// Activate and position cursor
 				is_active_ = true ;
 				
-				float click_x = mouse_pos.x - bound_.x - text_offset_.x - 10 ;
-				
-				if (click_x <= 0) {
-					cursor_index_ = 0 ;
-				} else {
-					size_t n = text_.size() ;
-					bool found = false ;
-					for (size_t i = 0; i < n; ++i) {
-						// lebar sebelum karakter i (substring 0..i-1)
-						std::wstring before = text_.substr(0, i) ;
-						std::wstring through = text_.substr(0, i + 1) ;
-						float w_before = Renderer::GetStringBound(font_, before).w ;
-						float w_through = Renderer::GetStringBound(font_, through).w ;
-						float mid = (w_before + w_through) / 2.0f ;
-						if (click_x < mid) {
-							cursor_index_ = i ;
-							found = true ;
-							break ;
-						}
-					}
-					if (!found) {
-						cursor_index_ = n ;
-					}
-				}
+				cursor_index_ = HitTest(mouse_pos.x - bound_.x - text_offset_.x - 10) ;
 				
 				// Reset cursor blink
 				cursor_visible_ = true ;
 				cursor_timer_ = 0 ;
-				update_ = true ;
+				MarkDirty() ;
 				
 				return true ;
 			} else {
@@ -209,7 +224,7 @@ namespace zketch {
 				if (was_active) {
 					is_active_ = false ;
 					cursor_visible_ = false ;
-					update_ = true ;
+					MarkDirty() ;
 				}
 				return false ;
 			}
@@ -231,7 +246,7 @@ namespace zketch {
 			if (cursor_timer_ >= cursor_interval_) {
 				cursor_visible_ = !cursor_visible_ ;
 				cursor_timer_ = 0 ;
-				update_ = true ;
+				MarkDirty() ;
 			}
 			last_update_ = now ;
 		}
@@ -242,7 +257,7 @@ namespace zketch {
 				AutoScrollToCursor() ;
 				cursor_visible_ = true ;
 				cursor_timer_ = 0 ;
-				update_ = true ;
+				MarkDirty() ;
 			}
 		}
 
@@ -252,7 +267,7 @@ namespace zketch {
 				AutoScrollToCursor() ;
 				cursor_visible_ = true ;
 				cursor_timer_ = 0 ;
-				update_ = true ;
+				MarkDirty() ;
 			}
 		}
 
@@ -261,7 +276,7 @@ namespace zketch {
 			AutoScrollToCursor() ;
 			cursor_visible_ = true ;
 			cursor_timer_ = 0 ;
-			update_ = true ;
+			MarkDirty() ;
 		}
 
 		void MoveCursorToEnd() noexcept {
@@ -269,52 +284,56 @@ namespace zketch {
 			AutoScrollToCursor() ;
 			cursor_visible_ = true ;
 			cursor_timer_ = 0 ;
-			update_ = true ;
+			MarkDirty() ;
 		}
 
 		void Insert(wchar_t c) noexcept { 
 			text_.insert(text_.begin() + cursor_index_, c) ;
+			InsertPrefix(cursor_index_) ;
 			++cursor_index_ ;
 			AutoScrollToCursor() ;
 			cursor_visible_ = true ;
 			cursor_timer_ = 0 ;
-			update_ = true ;
+			MarkDirty() ;
 		}
 
 		void Backspace() noexcept { 
 			if (cursor_index_ > 0) {
 				text_.erase(cursor_index_ - 1, 1) ;
 				--cursor_index_ ;
+				ErasePrefix(cursor_index_) ;
 				AutoScrollToCursor() ;
 				cursor_visible_ = true ;
 				cursor_timer_ = 0 ;
-				update_ = true ;
+				MarkDirty() ;
 			}
 		}
 
 		void Delete() noexcept {
 			if (cursor_index_ < text_.size()) {
 				text_.erase(cursor_index_, 1) ;
+				ErasePrefix(cursor_index_) ;
 				AutoScrollToCursor() ;
 				cursor_visible_ = true ;
 				cursor_timer_ = 0 ;
-				update_ = true ;
+				MarkDirty() ;
 			}
 		}
 
 		void Clear() noexcept {
 			text_.clear() ;
+			prefix_.assign(1, 0.0f) ;
 			cursor_index_ = 0 ;
 			text_offset_.x = 0 ;
 			cursor_visible_ = true ;
 			cursor_timer_ = 0 ;
-			update_ = true ;
+			MarkDirty() ;
 		}
 
 		void Submit() noexcept {
 			is_active_ = false ;
 			cursor_visible_ = false ;
-			update_ = true ;
+			MarkDirty() ;
 			
 			if (callback_) {
 				callback_() ;
@@ -323,43 +342,75 @@ namespace zketch {
 
 		void Deactivate() noexcept {
 			cursor_visible_ = false ;
-			update_ = true ;
+			MarkDirty() ;
 		}
 
 		// setter
 
 		void SetText(const std::wstring_view& text) noexcept {
 			text_ = text ;
+			RebuildPrefix() ;
 			cursor_index_ = text_.size() ;
 			AutoScrollToCursor() ;
-			update_ = true ;
+			MarkDirty() ;
 		}
 
 		void SetCursorInterval(uint32_t ms) noexcept { 
 			cursor_interval_ = ms ; 
-			update_ = true ;
+			MarkDirty() ;
 		}
 
 		void SetCursorIndex(size_t index) noexcept { 
 			cursor_index_ = index ; 
 			AutoScrollToCursor() ;
-			update_ = true ;
+			MarkDirty() ;
 		}
 
 		void SetTextOffset(const PointF& offset) noexcept { 
 			text_offset_ = offset ; 
-			update_ = true ;
+			MarkDirty() ;
 		}
 
 		void SetDrawingLogic(std::function<void(Canvas*, const InputBox&)> drawing_logic) noexcept {
 			drawing_logic_ = std::move(drawing_logic) ;
-			update_ = true ;
+			MarkDirty() ;
 		}
 
 		void SetCallback(std::function<void()> callback) noexcept {
 			callback_ = std::move(callback) ;
 		}
 
+		// sama dengan GetStringBound(text_.substr(0, index)).w tanpa mengukur ulang
+		float GetCaretOffset(size_t index) const noexcept {
+			index = std::min(index, text_.size()) ;
+			return index ? prefix_[index] + Metrics().GetPadding() : 0.0f ;
+		}
+
+		// index caret terdekat dari x relatif ke awal teks, batasnya titik tengah glyph
+		size_t HitTest(float x) const noexcept {
+			if (x <= 0.0f || text_.empty()) {
+				return 0 ;
+			}
+
+			float padding = Metrics().GetPadding() ;
+			size_t lo = 0, hi = text_.size() ;
+			while (lo < hi) {
+				size_t mid = lo + (hi - lo) / 2 ;
+				float center = (prefix_[mid] + prefix_[mid + 1]) * 0.5f + padding ;
+				if (mid == 0) {
+					center = (prefix_[1] + padding) * 0.5f ;
+				}
+				if (x < center) {
+					hi = mid ;
+				} else {
+					lo = mid + 1 ;
+				}
+			}
+			return lo ;
+		}
+
+		float GetLineHeight() const noexcept { return Metrics().GetLineHeight() ; }
+
 		// getter
 
 		const Font& GetFont() const noexcept { return font_ ; }
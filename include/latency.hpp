@@ -0,0 +1,86 @@
+#pragma once
+#include "framepacer.hpp"
+
+namespace zketch {
+
+	// jam untuk timestamp event dan LatencyTracker : nanodetik steady_clock
+	inline uint64_t EventClockNow() noexcept {
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count()) ;
+	}
+
+	// latensi input : 0 .. 256 ms per 0.5 ms
+	using LatencyHistogram = BasicHistogram<512, 500> ;
+
+	// latensi input-to-present untuk satu window. input dicatat saat di-poll, dianggap
+	// berefek bila window itu menerima frame berisi perubahan sesudahnya (NoteUpdate,
+	// dipanggil Renderer::End untuk window target), lalu latensinya dicatat pada present
+	// berikutnya yang benar-benar menyalin pixel. input yang belum diikuti update saat
+	// present tidak pernah tampil dan dibuang (GetDiscarded).
+	class LatencyTracker {
+	public :
+		static constexpr size_t MaxPending = 64 ;
+
+	private :
+		struct Pending {
+			uint64_t timestamp_ ;
+			uint64_t updates_ ; // jumlah update saat input dicatat
+		} ;
+
+		std::array<Pending, MaxPending> pending_ {} ;
+		size_t count_ = 0 ;
+		LatencyHistogram histogram_ {} ;
+		uint64_t discarded_ = 0 ;
+		uint64_t overflow_ = 0 ;
+		uint64_t updates_ = 0 ;
+
+	public :
+		// frame dengan perubahan dirender ke window pemilik tracker ini
+		void NoteUpdate() noexcept { ++updates_ ; }
+		uint64_t GetUpdateCount() const noexcept { return updates_ ; }
+
+		// timestamp dari Event::GetTimeStamp. bila penuh, input terlama yang dipertahankan
+		void Input(uint64_t timestamp) noexcept {
+			if (count_ == MaxPending) {
+				++overflow_ ;
+				return ;
+			}
+			pending_[count_++] = {timestamp, updates_} ;
+		}
+
+		// presented = present ini menyalin pixel ke layar. return jumlah latensi yang dicatat
+		size_t Present(uint64_t now, bool presented = true) noexcept {
+			size_t recorded = 0 ;
+			size_t kept = 0 ;
+			for (size_t i = 0; i < count_; ++i) {
+				const Pending& p = pending_[i] ;
+				if (p.updates_ == updates_) {
+					++discarded_ ;
+				} else if (!presented) {
+					// efeknya belum sampai ke layar
+					pending_[kept++] = p ;
+				} else {
+					histogram_.Record(now > p.timestamp_ ? static_cast<double>(now - p.timestamp_) / 1.0e6 : 0.0) ;
+					++recorded ;
+				}
+			}
+			count_ = kept ;
+			return recorded ;
+		}
+
+		void Reset() noexcept {
+			count_ = 0 ;
+			histogram_.Reset() ;
+			discarded_ = 0 ;
+			overflow_ = 0 ;
+		}
+
+		// dalam ms
+		double GetP50() const noexcept { return histogram_.Percentile(0.50) ; }
+		double GetP99() const noexcept { return histogram_.Percentile(0.99) ; }
+
+		const LatencyHistogram& GetHistogram() const noexcept { return histogram_ ; }
+		size_t GetPendingCount() const noexcept { return count_ ; }
+		uint64_t GetDiscarded() const noexcept { return discarded_ ; }
+		uint64_t GetOverflow() const noexcept { return overflow_ ; }
+	} ;
+}
\ No newline at end of file
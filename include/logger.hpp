@@ -6,6 +6,7 @@ namespace zketch {
 
     class logger {
     private :
+    #ifdef ZKETCH_WIN32
         static inline HANDLE out_handle() noexcept {
             static HANDLE h = GetStdHandle(STD_OUTPUT_HANDLE) ;
             return h ;
@@ -25,6 +26,23 @@ namespace zketch {
         static inline void restore_color(WORD old) noexcept {
             SetConsoleTextAttribute(out_handle(), old) ;
         }
+    #else
+        // headless : warna pakai ANSI escape, output ke stdout
+        static inline const char* ansi_color(int32_t lv) noexcept {
+            switch (lv) {
+                case 0 : return "\x1b[92m" ;
+                case 1 : return "\x1b[93m" ;
+                case 2 : return "\x1b[91m" ;
+                default : return "\x1b[0m" ;
+            }
+        }
+
+        static inline void write_out(int32_t lv, const std::string& buf) noexcept {
+            std::fputs(ansi_color(lv), stdout) ;
+            std::fwrite(buf.data(), 1, buf.size(), stdout) ;
+            std::fputs("\x1b[0m", stdout) ;
+        }
+    #endif
 
         template <typename T>
         static inline void append_narrow(std::string& out, T&& v) { // Terima dengan forwarding reference
@@ -63,11 +81,15 @@ namespace zketch {
 
         static inline void widen_utf8_to_wide(const char* src, int src_len, std::wstring& dst) {
             if (src_len <= 0) return ;
+        #ifdef ZKETCH_WIN32
             int needed = MultiByteToWideChar(CP_UTF8, 0, src, src_len, nullptr, 0) ;
             if (needed <= 0) return ;
             size_t old_size = dst.size();
             dst.resize(old_size + needed) ;
             MultiByteToWideChar(CP_UTF8, 0, src, src_len, dst.data() + old_size, needed) ;
+        #else
+            dst.append(src, src + src_len) ;
+        #endif
         }
 
         static inline void widen_utf8_to_wide(const std::string_view& sv, std::wstring& dst) {
@@ -116,6 +138,7 @@ namespace zketch {
             (append_narrow(buf, std::forward<Args>(args)), ...) ;
             buf.push_back('\n') ;
 
+        #ifdef ZKETCH_WIN32
             CONSOLE_SCREEN_BUFFER_INFO info ;
             GetConsoleScreenBufferInfo(out_handle(), &info) ;
             WORD old = info.wAttributes ;
@@ -123,6 +146,9 @@ namespace zketch {
             DWORD written = 0 ;
             WriteConsoleA(out_handle(), buf.data(), static_cast<DWORD>(buf.size()), &written, nullptr) ;
             restore_color(old) ;
+        #else
+            write_out(lv, buf) ;
+        #endif
         }
 
         template <typename ... Args>
@@ -135,6 +161,7 @@ namespace zketch {
             (append_wide(buf, std::forward<Args>(args)), ...) ; // <-- PERBAIKAN: std::forward
             buf.push_back(L'\n') ;
 
+        #ifdef ZKETCH_WIN32
             CONSOLE_SCREEN_BUFFER_INFO info ;
             GetConsoleScreenBufferInfo(out_handle(), &info) ;
             WORD old = info.wAttributes ;
@@ -142,6 +169,15 @@ namespace zketch {
             DWORD written = 0 ;
             WriteConsoleW(out_handle(), buf.data(), static_cast<DWORD>(buf.size()), &written, nullptr) ;
             restore_color(old) ;
+        #else
+            // headless : karakter non-ASCII diganti '?'
+            std::string narrow ;
+            narrow.reserve(buf.size()) ;
+            for (wchar_t c : buf) {
+                narrow.push_back(c < 0x80 ? static_cast<char>(c) : '?') ;
+            }
+            write_out(lv, narrow) ;
+        #endif
         }
 
     public :
@@ -0,0 +1,133 @@
+#pragma once
+#include "logger.hpp"
+
+namespace zketch {
+
+	// cache LRU dengan kapasitas tetap. setelah penuh, node list dan node map milik entry
+	// terlama dipakai ulang sehingga miss tidak menambah alokasi container.
+	template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+	class LruCache {
+	private :
+		using Entry = std::pair<Key, Value> ;
+		using List = std::list<Entry> ;
+
+		List entries_ ; // depan = paling baru dipakai
+		std::unordered_map<Key, typename List::iterator, Hash, KeyEqual> index_ ;
+		size_t capacity_ = 0 ;
+		uint64_t hits_ = 0 ;
+		uint64_t misses_ = 0 ;
+		uint64_t evictions_ = 0 ;
+
+		// hapus entry index yang menunjuk ke it. key yang tidak sama dengan dirinya
+		// sendiri (mis. float NaN) tidak bisa dicari, jadi jatuh ke pencarian linear.
+		void Unindex(typename List::iterator it) noexcept {
+			auto found = index_.find(it->first) ;
+			if (found != index_.end() && found->second == it) {
+				index_.erase(found) ;
+				return ;
+			}
+
+			for (auto i = index_.begin(); i != index_.end(); ++i) {
+				if (i->second == it) {
+					index_.erase(i) ;
+					return ;
+				}
+			}
+		}
+
+		void Trim() noexcept {
+			while (entries_.size() > capacity_) {
+				Unindex(std::prev(entries_.end())) ;
+				entries_.pop_back() ;
+				++evictions_ ;
+			}
+		}
+
+	public :
+		LruCache(const LruCache&) = delete ;
+		LruCache& operator=(const LruCache&) = delete ;
+		LruCache(LruCache&&) noexcept = default ;
+		LruCache& operator=(LruCache&&) noexcept = default ;
+
+		explicit LruCache(size_t capacity) noexcept : capacity_(capacity ? capacity : 1) {
+			index_.reserve(capacity_) ;
+		}
+
+		// tidak mengubah statistik, hanya memajukan entry bila ada
+		Value* Find(const Key& key) noexcept {
+			auto it = index_.find(key) ;
+			if (it == index_.end()) {
+				return nullptr ;
+			}
+
+			entries_.splice(entries_.begin(), entries_, it->second) ;
+			return &it->second->second ;
+		}
+
+		// make() -> Value, hanya dipanggil saat miss
+		template <typename Factory>
+		Value& GetOrCreate(const Key& key, Factory&& make) {
+			auto it = index_.find(key) ;
+			if (it != index_.end()) {
+				++hits_ ;
+				entries_.splice(entries_.begin(), entries_, it->second) ;
+				return it->second->second ;
+			}
+
+			++misses_ ;
+
+			if (entries_.size() >= capacity_) {
+				Value value = make() ;
+				auto last = std::prev(entries_.end()) ;
+				auto node = index_.extract(last->first) ;
+				if (node.empty()) {
+					Unindex(last) ;
+				}
+				last->first = key ;
+				last->second = std::move(value) ;
+				entries_.splice(entries_.begin(), entries_, last) ;
+				if (!node.empty()) {
+					node.key() = key ;
+					index_.insert(std::move(node)) ;
+				} else {
+					index_.emplace(key, last) ;
+				}
+				++evictions_ ;
+				return last->second ;
+			}
+
+			entries_.emplace_front(key, make()) ;
+			index_.emplace(key, entries_.begin()) ;
+			return entries_.front().second ;
+		}
+
+		bool Contains(const Key& key) const noexcept {
+			return index_.find(key) != index_.end() ;
+		}
+
+		void SetCapacity(size_t capacity) noexcept {
+			capacity_ = capacity ? capacity : 1 ;
+			Trim() ;
+		}
+
+		void Clear() noexcept {
+			index_.clear() ;
+			entries_.clear() ;
+		}
+
+		void ResetStats() noexcept {
+			hits_ = 0 ;
+			misses_ = 0 ;
+			evictions_ = 0 ;
+		}
+
+		size_t GetSize() const noexcept { return entries_.size() ; }
+		size_t GetCapacity() const noexcept { return capacity_ ; }
+		uint64_t GetHits() const noexcept { return hits_ ; }
+		uint64_t GetMisses() const noexcept { return misses_ ; }
+		uint64_t GetEvictions() const noexcept { return evictions_ ; }
+
+		// untuk iterasi dari paling baru ke paling lama
+		const List& GetEntries() const noexcept { return entries_ ; }
+	} ;
+}
\ No newline at end of file
@@ -0,0 +1,251 @@
+#pragma once
+#include "logger.hpp"
+
+namespace zketch {
+
+	inline constexpr size_t CacheLineSize = 64 ;
+
+	// ring buffer lock-free berkapasitas tetap untuk banyak producer dan satu consumer.
+	// tiap slot punya nomor urut sendiri (skema bounded queue Vyukov) : producer merebut
+	// posisi tail dengan CAS, lalu menerbitkan slot dengan store release pada nomor urut.
+	// tidak ada alokasi setelah konstruksi. head, tail dan tiap slot dipisah per cache line
+	// supaya producer yang berbeda tidak saling mengotori cache line.
+	// pop juga memakai CAS, jadi producer boleh membuang item terlama (DropOldest).
+	template <typename T, size_t Capacity>
+	class MpscRing {
+		static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two") ;
+
+	private :
+		static constexpr size_t Mask = Capacity - 1 ;
+
+		struct alignas(CacheLineSize) Slot {
+			std::atomic<size_t> seq_ ;
+			T value_ ;
+		} ;
+
+		alignas(CacheLineSize) std::atomic<size_t> tail_ {0} ;
+		alignas(CacheLineSize) std::atomic<size_t> head_ {0} ;
+		alignas(CacheLineSize) std::atomic<uint64_t> dropped_ {0} ;
+		std::atomic<OverflowPolicy> policy_ {OverflowPolicy::Reject} ;
+		std::unique_ptr<Slot[]> slots_ ;
+
+	public :
+		MpscRing(const MpscRing&) = delete ;
+		MpscRing& operator=(const MpscRing&) = delete ;
+
+		MpscRing() : slots_(new Slot[Capacity]) {
+			for (size_t i = 0; i < Capacity; ++i) {
+				slots_[i].seq_.store(i, std::memory_order_relaxed) ;
+			}
+		}
+
+		// false bila penuh, tanpa memandang policy
+		bool TryPush(const T& item) noexcept {
+			size_t pos = tail_.load(std::memory_order_relaxed) ;
+			Slot* slot ;
+			for (;;) {
+				slot = &slots_[pos & Mask] ;
+				size_t seq = slot->seq_.load(std::memory_order_acquire) ;
+				intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos) ;
+				if (diff == 0) {
+					if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						break ;
+					}
+				} else if (diff < 0) {
+					return false ;
+				} else {
+					pos = tail_.load(std::memory_order_relaxed) ;
+				}
+			}
+
+			slot->value_ = item ;
+			slot->seq_.store(pos + 1, std::memory_order_release) ;
+			return true ;
+		}
+
+		bool TryPop(T& out) noexcept {
+			size_t pos = head_.load(std::memory_order_relaxed) ;
+			Slot* slot ;
+			for (;;) {
+				slot = &slots_[pos & Mask] ;
+				size_t seq = slot->seq_.load(std::memory_order_acquire) ;
+				intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) ;
+				if (diff == 0) {
+					if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+						break ;
+					}
+				} else if (diff < 0) {
+					return false ;
+				} else {
+					pos = head_.load(std::memory_order_relaxed) ;
+				}
+			}
+
+			out = slot->value_ ;
+			slot->seq_.store(pos + Capacity, std::memory_order_release) ;
+			return true ;
+		}
+
+		// klaim sampai n slot kosong berurutan dengan satu CAS, return jumlah yang masuk
+		// (item terdepan lebih dulu). tanpa memandang policy.
+		size_t TryPushBulk(const T* items, size_t n) noexcept {
+			n = std::min(n, Capacity) ;
+			size_t pos = tail_.load(std::memory_order_relaxed) ;
+			size_t k ;
+			for (;;) {
+				k = 0 ;
+				bool stale = false ;
+				while (k < n) {
+					size_t seq = slots_[(pos + k) & Mask].seq_.load(std::memory_order_acquire) ;
+					intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + k) ;
+					if (diff == 0) {
+						++k ;
+					} else {
+						stale = diff > 0 ;
+						break ;
+					}
+				}
+
+				if (stale && k == 0) {
+					pos = tail_.load(std::memory_order_relaxed) ;
+					continue ;
+				}
+				if (k == 0) {
+					return 0 ;
+				}
+				if (tail_.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed)) {
+					break ;
+				}
+			}
+
+			for (size_t i = 0; i < k; ++i) {
+				Slot& slot = slots_[(pos + i) & Mask] ;
+				slot.value_ = items[i] ;
+				slot.seq_.store(pos + i + 1, std::memory_order_release) ;
+			}
+			return k ;
+		}
+
+		// ambil sampai max item yang sudah terbit berurutan dengan satu CAS
+		size_t TryPopBulk(T* out, size_t max) noexcept {
+			max = std::min(max, Capacity) ;
+			size_t pos = head_.load(std::memory_order_relaxed) ;
+			size_t k ;
+			for (;;) {
+				k = 0 ;
+				bool stale = false ;
+				while (k < max) {
+					size_t seq = slots_[(pos + k) & Mask].seq_.load(std::memory_order_acquire) ;
+					intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + k + 1) ;
+					if (diff == 0) {
+						++k ;
+					} else {
+						stale = diff > 0 ;
+						break ;
+					}
+				}
+
+				if (stale && k == 0) {
+					pos = head_.load(std::memory_order_relaxed) ;
+					continue ;
+				}
+				if (k == 0) {
+					return 0 ;
+				}
+				if (head_.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed)) {
+					break ;
+				}
+			}
+
+			for (size_t i = 0; i < k; ++i) {
+				Slot& slot = slots_[(pos + i) & Mask] ;
+				out[i] = slot.value_ ;
+				slot.seq_.store(pos + i + Capacity, std::memory_order_release) ;
+			}
+			return k ;
+		}
+
+		// push dengan overflow policy. false hanya bila item ini yang dibuang (Reject).
+		bool Push(const T& item) noexcept {
+			if (TryPush(item)) {
+				return true ;
+			}
+
+			switch (policy_.load(std::memory_order_relaxed)) {
+				case OverflowPolicy::DropOldest : {
+					T oldest ;
+					do {
+						if (TryPop(oldest)) {
+							dropped_.fetch_add(1, std::memory_order_relaxed) ;
+						}
+					} while (!TryPush(item)) ;
+					return true ;
+				}
+
+				case OverflowPolicy::Spin :
+					do {
+						std::this_thread::yield() ;
+					} while (!TryPush(item)) ;
+					return true ;
+
+				default :
+					dropped_.fetch_add(1, std::memory_order_relaxed) ;
+					return false ;
+			}
+		}
+
+		// versi bulk dari Push. dengan Reject, item yang tidak muat dibuang semua
+		// (sisa di belakang, jadi yang masuk selalu prefix). return jumlah yang masuk.
+		size_t PushBulk(const T* items, size_t n) noexcept {
+			size_t done = 0 ;
+			while (done < n) {
+				size_t k = TryPushBulk(items + done, n - done) ;
+				if (k == 0) {
+					break ;
+				}
+				done += k ;
+			}
+
+			if (done < n && policy_.load(std::memory_order_relaxed) == OverflowPolicy::Reject) {
+				dropped_.fetch_add(n - done, std::memory_order_relaxed) ;
+				return done ;
+			}
+
+			for (; done < n; ++done) {
+				Push(items[done]) ;
+			}
+			return done ;
+		}
+
+		// fn(item) untuk item yang ada saat ini, hanya dari thread consumer
+		template <typename Fn>
+		size_t Drain(Fn&& fn) {
+			size_t n = 0 ;
+			T item ;
+			while (TryPop(item)) {
+				fn(item) ;
+				++n ;
+			}
+			return n ;
+		}
+
+		void Clear() noexcept {
+			T item ;
+			while (TryPop(item)) {}
+		}
+
+		void SetOverflowPolicy(OverflowPolicy policy) noexcept { policy_.store(policy, std::memory_order_relaxed) ; }
+		OverflowPolicy GetOverflowPolicy() const noexcept { return policy_.load(std::memory_order_relaxed) ; }
+
+		// perkiraan, bisa sudah berubah saat dibaca
+		size_t GetSize() const noexcept {
+			size_t tail = tail_.load(std::memory_order_acquire) ;
+			size_t head = head_.load(std::memory_order_acquire) ;
+			return tail > head ? std::min(tail - head, Capacity) : 0 ;
+		}
+
+		bool IsEmpty() const noexcept { return GetSize() == 0 ; }
+		uint64_t GetDropped() const noexcept { return dropped_.load(std::memory_order_relaxed) ; }
+		static constexpr size_t GetCapacity() noexcept { return Capacity ; }
+	} ;
+}
\ No newline at end of file
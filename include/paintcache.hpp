@@ -0,0 +1,90 @@
+#pragma once
+#include "unit.hpp"
+#include "lrucache.hpp"
+
+namespace zketch {
+
+	// brush memakai thickness 0 dan style 0
+	struct PaintKey {
+		uint32_t color_ = 0 ;
+		float thickness_ = 0.0f ;
+		uint8_t style_ = 0 ;
+
+		constexpr bool operator==(const PaintKey& o) const noexcept {
+			return color_ == o.color_ && thickness_ == o.thickness_ && style_ == o.style_ ;
+		}
+	} ;
+
+	struct PaintKeyHash {
+		size_t operator()(const PaintKey& k) const noexcept {
+			// + 0.0f : -0.0f jadi +0.0f, sama dengan operator==
+			float thickness = k.thickness_ + 0.0f ;
+			uint32_t bits ;
+			std::memcpy(&bits, &thickness, sizeof(bits)) ;
+			uint64_t h = (static_cast<uint64_t>(k.color_) << 32) ^ (static_cast<uint64_t>(bits) * 0x9E3779B1u) ^ k.style_ ;
+			h ^= h >> 29 ;
+			h *= 0xBF58476D1CE4E5B9ull ;
+			h ^= h >> 32 ;
+			return static_cast<size_t>(h) ;
+		}
+	} ;
+
+#ifdef ZKETCH_WIN32
+	// pen dan brush GDI+ per thread, dipakai bersama semua Renderer di thread itu.
+	// object hasil Get*() milik cache, jangan diubah atau dihapus pemanggil.
+	class PaintCache {
+	private :
+		LruCache<PaintKey, std::unique_ptr<Gdiplus::Pen>, PaintKeyHash> pens_ ;
+		LruCache<PaintKey, std::unique_ptr<Gdiplus::SolidBrush>, PaintKeyHash> brushes_ ;
+
+	public :
+		static constexpr size_t DefaultCapacity = 64 ;
+
+		explicit PaintCache(size_t capacity = DefaultCapacity) noexcept : pens_(capacity), brushes_(capacity) {}
+
+		// thread_local milik thread utama dihancurkan sebelum static GDISession__, jadi aman
+		static PaintCache& ForThread() noexcept {
+			static thread_local PaintCache cache ;
+			return cache ;
+		}
+
+		Gdiplus::Pen* GetPen(const Color& color, float thickness, Gdiplus::DashStyle style = Gdiplus::DashStyleSolid) noexcept {
+			PaintKey key {color.ABGR, thickness, static_cast<uint8_t>(style)} ;
+			return pens_.GetOrCreate(key, [&] {
+				auto pen = std::make_unique<Gdiplus::Pen>(color, thickness) ;
+				if (style != Gdiplus::DashStyleSolid) {
+					pen->SetDashStyle(style) ;
+				}
+				return pen ;
+			}).get() ;
+		}
+
+		Gdiplus::SolidBrush* GetBrush(const Color& color) noexcept {
+			PaintKey key {color.ABGR, 0.0f, 0} ;
+			return brushes_.GetOrCreate(key, [&] {
+				return std::make_unique<Gdiplus::SolidBrush>(color) ;
+			}).get() ;
+		}
+
+		void SetCapacity(size_t capacity) noexcept {
+			pens_.SetCapacity(capacity) ;
+			brushes_.SetCapacity(capacity) ;
+		}
+
+		void Clear() noexcept {
+			pens_.Clear() ;
+			brushes_.Clear() ;
+		}
+
+		void ResetStats() noexcept {
+			pens_.ResetStats() ;
+			brushes_.ResetStats() ;
+		}
+
+		uint64_t GetHits() const noexcept { return pens_.GetHits() + brushes_.GetHits() ; }
+		uint64_t GetMisses() const noexcept { return pens_.GetMisses() + brushes_.GetMisses() ; }
+		const auto& GetPenCache() const noexcept { return pens_ ; }
+		const auto& GetBrushCache() const noexcept { return brushes_ ; }
+	} ;
+#endif
+}
\ No newline at end of file
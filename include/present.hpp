@@ -0,0 +1,280 @@
+#pragma once
+#include "canvas.hpp"
+
+namespace zketch {
+
+	struct PresentStats {
+		uint64_t bytes_copied_ = 0 ;
+		uint32_t rect_count_ = 0 ;
+		bool full_ = false ;
+		// semua rect terpilih sampai ke target. false : damage harus dipertahankan
+		bool presented_ = false ;
+	} ;
+
+	// di atas rasio ini (luas damage / luas canvas) satu blit penuh lebih murah dari banyak blit kecil
+	inline constexpr float DefaultPresentThreshold = 0.5f ;
+
+	// isi out dengan rect yang perlu disalin, return true bila fallback ke blit penuh
+	inline bool SelectPresentRects(const DamageRegion& region, const Size& size, float threshold, std::vector<Rect>& out) noexcept {
+		out.clear() ;
+		if (region.IsEmpty() || size.x == 0 || size.y == 0) {
+			return false ;
+		}
+
+		Rect full {0, 0, size.x, size.y} ;
+		uint64_t total = static_cast<uint64_t>(size.x) * size.y ;
+		if (static_cast<float>(region.GetArea()) >= static_cast<float>(total) * threshold) {
+			out.push_back(full) ;
+			return true ;
+		}
+
+		for (const auto& r : region.GetRects()) {
+			int64_t x0 = std::max<int64_t>(r.x, 0) ;
+			int64_t y0 = std::max<int64_t>(r.y, 0) ;
+			int64_t x1 = std::min<int64_t>(static_cast<int64_t>(r.x) + r.w, size.x) ;
+			int64_t y1 = std::min<int64_t>(static_cast<int64_t>(r.y) + r.h, size.y) ;
+			if (x1 > x0 && y1 > y0) {
+				out.emplace_back(static_cast<int32_t>(x0), static_cast<int32_t>(y0), static_cast<uint32_t>(x1 - x0), static_cast<uint32_t>(y1 - y0)) ;
+			}
+		}
+
+		return false ;
+	}
+
+	// tujuan present yang dipilih saat runtime (mis. Window::SetPresentTarget).
+	// PresentRegion juga menerima tipe apa pun dengan tiga method yang sama.
+	class PresentTarget {
+	public :
+		virtual ~PresentTarget() = default ;
+
+		virtual bool BeginPresent(const Canvas& src) noexcept = 0 ;
+		virtual bool CopyRect(const Canvas& src, const Rect& area) noexcept = 0 ;
+		virtual void EndPresent() noexcept = 0 ;
+	} ;
+
+	// Target cukup menyediakan :
+	//   bool BeginPresent(const Canvas& src)
+	//   bool CopyRect(const Canvas& src, const Rect& area)
+	//   void EndPresent()
+	template <typename Target>
+	PresentStats PresentRegion(const Canvas& src, const DamageRegion& region, Target& target, float threshold, std::vector<Rect>& scratch) noexcept {
+		PresentStats stats ;
+		if (!src.IsValid()) {
+			return stats ;
+		}
+
+		stats.full_ = SelectPresentRects(region, src.GetSize(), threshold, scratch) ;
+		if (scratch.empty() || !target.BeginPresent(src)) {
+			stats.full_ = false ;
+			return stats ;
+		}
+
+		for (const auto& r : scratch) {
+			if (target.CopyRect(src, r)) {
+				stats.bytes_copied_ += static_cast<uint64_t>(r.w) * r.h * sizeof(uint32_t) ;
+				++stats.rect_count_ ;
+			}
+		}
+
+		target.EndPresent() ;
+		stats.presented_ = stats.rect_count_ == scratch.size() ;
+		return stats ;
+	}
+
+	// target present di memori, untuk headless dan pengujian
+	class MemoryPresentTarget final : public PresentTarget {
+	private :
+		PixelBuffer pixels_ {} ;
+
+	public :
+		bool BeginPresent(const Canvas& src) noexcept override {
+			if (pixels_.GetSize() != src.GetSize()) {
+				return pixels_.Create(src.GetSize()) ;
+			}
+			return pixels_.IsValid() ;
+		}
+
+		bool CopyRect(const Canvas& src, const Rect& area) noexcept override {
+			if (const PixelBuffer* pixels = src.GetPixels()) {
+				for (uint32_t y = 0; y < area.h; ++y) {
+					span_ops::copy_row(pixels_.GetRow(area.y + y) + area.x, pixels->GetRow(area.y + y) + area.x, area.w) ;
+				}
+				return true ;
+			}
+
+		#ifdef ZKETCH_WIN32
+			Gdiplus::BitmapData data ;
+			Gdiplus::Rect lock(area.x, area.y, static_cast<INT>(area.w), static_cast<INT>(area.h)) ;
+			if (src.GetBitmap()->LockBits(&lock, Gdiplus::ImageLockModeRead, PixelFormat32bppPARGB, &data) != Gdiplus::Ok) {
+				return false ;
+			}
+
+			for (uint32_t y = 0; y < area.h; ++y) {
+				const auto* row = reinterpret_cast<const uint32_t*>(static_cast<const BYTE*>(data.Scan0) + static_cast<size_t>(y) * data.Stride) ;
+				span_ops::copy_row(pixels_.GetRow(area.y + y) + area.x, row, area.w) ;
+			}
+
+			src.GetBitmap()->UnlockBits(&data) ;
+			return true ;
+		#else
+			return false ;
+		#endif
+		}
+
+		void EndPresent() noexcept override {}
+
+		const PixelBuffer& GetPixels() const noexcept { return pixels_ ; }
+	} ;
+
+#ifdef ZKETCH_WIN32
+	// menyalin ke client area window lewat GDI+
+	class WindowPresentTarget final : public PresentTarget {
+	private :
+		HWND handle_ = nullptr ;
+		HDC hdc_ = nullptr ;
+		std::unique_ptr<Gdiplus::Graphics> screen_ {} ;
+
+	public :
+		WindowPresentTarget(const WindowPresentTarget&) = delete ;
+		WindowPresentTarget& operator=(const WindowPresentTarget&) = delete ;
+
+		explicit WindowPresentTarget(HWND handle) noexcept : handle_(handle) {}
+
+		~WindowPresentTarget() noexcept override {
+			EndPresent() ;
+		}
+
+		bool BeginPresent(const Canvas& src) noexcept override {
+			if (!src.GetBitmap()) {
+				return false ;
+			}
+
+			hdc_ = GetDC(handle_) ;
+			if (!hdc_) {
+
+				#ifdef WINDOW_DEBUG
+					logger::warning("WindowPresentTarget::BeginPresent - Invalid HDC!") ;
+				#endif
+
+				return false ;
+			}
+
+			screen_ = std::make_unique<Gdiplus::Graphics>(hdc_) ;
+			if (screen_->GetLastStatus() != Gdiplus::Ok) {
+
+				#ifdef WINDOW_DEBUG
+					logger::error("WindowPresentTarget::BeginPresent - Graphics creation failed") ;
+				#endif
+
+				EndPresent() ;
+				return false ;
+			}
+
+			screen_->SetCompositingMode(Gdiplus::CompositingModeSourceOver) ;
+			screen_->SetCompositingQuality(Gdiplus::CompositingQualityHighSpeed) ;
+			screen_->SetInterpolationMode(Gdiplus::InterpolationModeNearestNeighbor) ;
+			return true ;
+		}
+
+		bool CopyRect(const Canvas& src, const Rect& area) noexcept override {
+			auto status = screen_->DrawImage(src.GetBitmap(), area.x, area.y, area.x, area.y, static_cast<INT>(area.w), static_cast<INT>(area.h), Gdiplus::UnitPixel) ;
+			if (status != Gdiplus::Ok) {
+
+				#ifdef WINDOW_DEBUG
+					logger::error("WindowPresentTarget::CopyRect - DrawImage failed: ", static_cast<int>(status)) ;
+				#endif
+
+				return false ;
+			}
+			return true ;
+		}
+
+		void EndPresent() noexcept override {
+			screen_.reset() ;
+			if (hdc_) {
+				ReleaseDC(handle_, hdc_) ;
+				hdc_ = nullptr ;
+			}
+		}
+	} ;
+
+	// memori canvas software sudah berformat DIB 32bpp top-down (BGRA), jadi langsung
+	// dikirim ke DC window dengan StretchDIBits 1:1 tanpa Bitmap / konversi format.
+	// hanya untuk canvas software, canvas GDI+ ditolak di BeginPresent.
+	class DibPresentTarget final : public PresentTarget {
+	private :
+		HWND handle_ = nullptr ;
+		HDC hdc_ = nullptr ;
+		BITMAPINFO info_ {} ;
+
+	public :
+		DibPresentTarget(const DibPresentTarget&) = delete ;
+		DibPresentTarget& operator=(const DibPresentTarget&) = delete ;
+
+		explicit DibPresentTarget(HWND handle) noexcept : handle_(handle) {
+			info_.bmiHeader.biSize = sizeof(BITMAPINFOHEADER) ;
+			info_.bmiHeader.biPlanes = 1 ;
+			info_.bmiHeader.biBitCount = 32 ;
+			info_.bmiHeader.biCompression = BI_RGB ;
+		}
+
+		~DibPresentTarget() noexcept override {
+			EndPresent() ;
+		}
+
+		bool BeginPresent(const Canvas& src) noexcept override {
+			const PixelBuffer* pixels = src.GetPixels() ;
+			if (!pixels) {
+				return false ;
+			}
+
+			hdc_ = GetDC(handle_) ;
+			if (!hdc_) {
+
+				#ifdef WINDOW_DEBUG
+					logger::warning("DibPresentTarget::BeginPresent - Invalid HDC!") ;
+				#endif
+
+				return false ;
+			}
+
+			// lebar DIB = stride, baris PixelBuffer selalu kelipatan 4 byte
+			info_.bmiHeader.biWidth = static_cast<LONG>(pixels->GetStride()) ;
+			return true ;
+		}
+
+		// DIB dimulai dari baris area.y dan tingginya area.h, jadi sumber selalu di y = 0
+		bool CopyRect(const Canvas& src, const Rect& area) noexcept override {
+			const PixelBuffer* pixels = src.GetPixels() ;
+			info_.bmiHeader.biHeight = -static_cast<LONG>(area.h) ;
+
+			int lines = StretchDIBits(
+				hdc_, 
+				area.x, area.y, static_cast<int>(area.w), static_cast<int>(area.h), 
+				area.x, 0, static_cast<int>(area.w), static_cast<int>(area.h), 
+				pixels->GetRow(static_cast<uint32_t>(area.y)), 
+				&info_, 
+				DIB_RGB_COLORS, 
+				SRCCOPY
+			) ;
+
+			if (lines == 0) {
+
+				#ifdef WINDOW_DEBUG
+					logger::error("DibPresentTarget::CopyRect - StretchDIBits failed.") ;
+				#endif
+
+				return false ;
+			}
+			return true ;
+		}
+
+		void EndPresent() noexcept override {
+			if (hdc_) {
+				ReleaseDC(handle_, hdc_) ;
+				hdc_ = nullptr ;
+			}
+		}
+	} ;
+#endif
+}
\ No newline at end of file
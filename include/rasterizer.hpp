@@ -0,0 +1,784 @@
+#pragma once
+#include "unit.hpp"
+#include "surfacepool.hpp"
+
+#if defined (__AVX2__)
+	#include <immintrin.h>
+	#define ZKETCH_SIMD_AVX2
+#endif
+
+#if defined (__SSE2__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define ZKETCH_SIMD_SSE2
+#endif
+
+namespace zketch {
+
+	// pixel software backend : 32-bit premultiplied ARGB (0xAARRGGBB),
+	// layout memori sama dengan Gdiplus PixelFormat32bppPARGB
+	inline constexpr uint32_t ToPixel(const Color& c) noexcept {
+		uint32_t a = c.GetA() ;
+		uint32_t r = (c.GetR() * a + 127) / 255 ;
+		uint32_t g = (c.GetG() * a + 127) / 255 ;
+		uint32_t b = (c.GetB() * a + 127) / 255 ;
+		return (a << 24) | (r << 16) | (g << 8) | b ;
+	}
+
+	namespace span_ops {
+
+		// dst * (255 - src.a) / 255 + src, dua channel sekaligus per 32-bit
+		inline uint32_t blend_pixel(uint32_t dst, uint32_t src) noexcept {
+			uint32_t ia = 255 - (src >> 24) ;
+			uint32_t rb = (dst & 0x00FF00FF) * ia + 0x00800080 ;
+			uint32_t ag = ((dst >> 8) & 0x00FF00FF) * ia + 0x00800080 ;
+			rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF ;
+			ag = (ag + ((ag >> 8) & 0x00FF00FF)) & 0xFF00FF00 ;
+			return src + rb + ag ;
+		}
+
+	#ifdef ZKETCH_SIMD_SSE2
+		inline __m128i mul_div255_sse2(__m128i v, __m128i a) noexcept {
+			__m128i t = _mm_add_epi16(_mm_mullo_epi16(v, a), _mm_set1_epi16(128)) ;
+			return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8) ;
+		}
+
+		inline __m128i alpha_inv_sse2(__m128i v) noexcept {
+			__m128i a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)) ;
+			return _mm_sub_epi16(_mm_set1_epi16(255), a) ;
+		}
+	#endif
+
+	#ifdef ZKETCH_SIMD_AVX2
+		inline __m256i mul_div255_avx2(__m256i v, __m256i a) noexcept {
+			__m256i t = _mm256_add_epi16(_mm256_mullo_epi16(v, a), _mm256_set1_epi16(128)) ;
+			return _mm256_srli_epi16(_mm256_add_epi16(t, _mm256_srli_epi16(t, 8)), 8) ;
+		}
+
+		inline __m256i alpha_inv_avx2(__m256i v) noexcept {
+			__m256i a = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(v, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3)) ;
+			return _mm256_sub_epi16(_mm256_set1_epi16(255), a) ;
+		}
+	#endif
+
+		// isi n pixel dengan warna yang sama (copy, tanpa blending)
+		inline void fill(uint32_t* dst, size_t n, uint32_t px) noexcept {
+			size_t i = 0 ;
+
+		#ifdef ZKETCH_SIMD_AVX2
+			__m256i v8 = _mm256_set1_epi32(static_cast<int32_t>(px)) ;
+			for (; i + 8 <= n; i += 8) {
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v8) ;
+			}
+		#endif
+
+		#ifdef ZKETCH_SIMD_SSE2
+			__m128i v4 = _mm_set1_epi32(static_cast<int32_t>(px)) ;
+			for (; i + 4 <= n; i += 4) {
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v4) ;
+			}
+		#endif
+
+			for (; i < n; ++i) {
+				dst[i] = px ;
+			}
+		}
+
+		// source-over n pixel dengan satu warna premultiplied
+		inline void blend(uint32_t* dst, size_t n, uint32_t px) noexcept {
+			size_t i = 0 ;
+
+		#ifdef ZKETCH_SIMD_AVX2
+			__m256i zero8 = _mm256_setzero_si256() ;
+			__m256i src8 = _mm256_set1_epi32(static_cast<int32_t>(px)) ;
+			__m256i ia8 = _mm256_set1_epi16(static_cast<int16_t>(255 - (px >> 24))) ;
+			for (; i + 8 <= n; i += 8) {
+				__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i)) ;
+				__m256i lo = mul_div255_avx2(_mm256_unpacklo_epi8(d, zero8), ia8) ;
+				__m256i hi = mul_div255_avx2(_mm256_unpackhi_epi8(d, zero8), ia8) ;
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_adds_epu8(_mm256_packus_epi16(lo, hi), src8)) ;
+			}
+		#endif
+
+		#ifdef ZKETCH_SIMD_SSE2
+			__m128i zero4 = _mm_setzero_si128() ;
+			__m128i src4 = _mm_set1_epi32(static_cast<int32_t>(px)) ;
+			__m128i ia4 = _mm_set1_epi16(static_cast<int16_t>(255 - (px >> 24))) ;
+			for (; i + 4 <= n; i += 4) {
+				__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i)) ;
+				__m128i lo = mul_div255_sse2(_mm_unpacklo_epi8(d, zero4), ia4) ;
+				__m128i hi = mul_div255_sse2(_mm_unpackhi_epi8(d, zero4), ia4) ;
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_adds_epu8(_mm_packus_epi16(lo, hi), src4)) ;
+			}
+		#endif
+
+			for (; i < n; ++i) {
+				dst[i] = blend_pixel(dst[i], px) ;
+			}
+		}
+
+		// source-over n pixel dari baris source premultiplied
+		inline void blend_row(uint32_t* dst, const uint32_t* src, size_t n) noexcept {
+			size_t i = 0 ;
+
+		#ifdef ZKETCH_SIMD_AVX2
+			__m256i zero8 = _mm256_setzero_si256() ;
+			for (; i + 8 <= n; i += 8) {
+				__m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)) ;
+				__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i)) ;
+				__m256i lo = mul_div255_avx2(_mm256_unpacklo_epi8(d, zero8), alpha_inv_avx2(_mm256_unpacklo_epi8(s, zero8))) ;
+				__m256i hi = mul_div255_avx2(_mm256_unpackhi_epi8(d, zero8), alpha_inv_avx2(_mm256_unpackhi_epi8(s, zero8))) ;
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_adds_epu8(_mm256_packus_epi16(lo, hi), s)) ;
+			}
+		#endif
+
+		#ifdef ZKETCH_SIMD_SSE2
+			__m128i zero4 = _mm_setzero_si128() ;
+			for (; i + 4 <= n; i += 4) {
+				__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)) ;
+				__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i)) ;
+				__m128i lo = mul_div255_sse2(_mm_unpacklo_epi8(d, zero4), alpha_inv_sse2(_mm_unpacklo_epi8(s, zero4))) ;
+				__m128i hi = mul_div255_sse2(_mm_unpackhi_epi8(d, zero4), alpha_inv_sse2(_mm_unpackhi_epi8(s, zero4))) ;
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_adds_epu8(_mm_packus_epi16(lo, hi), s)) ;
+			}
+		#endif
+
+			for (; i < n; ++i) {
+				dst[i] = blend_pixel(dst[i], src[i]) ;
+			}
+		}
+
+		// px * a / 255 untuk semua channel premultiplied
+		inline uint32_t scale_pixel(uint32_t px, uint32_t a) noexcept {
+			uint32_t rb = (px & 0x00FF00FF) * a + 0x00800080 ;
+			uint32_t ag = ((px >> 8) & 0x00FF00FF) * a + 0x00800080 ;
+			rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF ;
+			ag = (ag + ((ag >> 8) & 0x00FF00FF)) & 0xFF00FF00 ;
+			return rb | ag ;
+		}
+
+		// seperti blend_row, source dikali opacity (0 .. 255) terlebih dulu
+		inline void blend_row(uint32_t* dst, const uint32_t* src, size_t n, uint8_t opacity) noexcept {
+			if (opacity == 255) {
+				blend_row(dst, src, n) ;
+				return ;
+			}
+
+			if (opacity == 0) {
+				return ;
+			}
+
+			size_t i = 0 ;
+
+		#ifdef ZKETCH_SIMD_AVX2
+			__m256i zero8 = _mm256_setzero_si256() ;
+			__m256i op8 = _mm256_set1_epi16(opacity) ;
+			for (; i + 8 <= n; i += 8) {
+				__m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)) ;
+				__m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i)) ;
+				__m256i slo = mul_div255_avx2(_mm256_unpacklo_epi8(s, zero8), op8) ;
+				__m256i shi = mul_div255_avx2(_mm256_unpackhi_epi8(s, zero8), op8) ;
+				__m256i lo = _mm256_add_epi16(mul_div255_avx2(_mm256_unpacklo_epi8(d, zero8), alpha_inv_avx2(slo)), slo) ;
+				__m256i hi = _mm256_add_epi16(mul_div255_avx2(_mm256_unpackhi_epi8(d, zero8), alpha_inv_avx2(shi)), shi) ;
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_packus_epi16(lo, hi)) ;
+			}
+		#endif
+
+		#ifdef ZKETCH_SIMD_SSE2
+			__m128i zero4 = _mm_setzero_si128() ;
+			__m128i op4 = _mm_set1_epi16(opacity) ;
+			for (; i + 4 <= n; i += 4) {
+				__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i)) ;
+				__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i)) ;
+				__m128i slo = mul_div255_sse2(_mm_unpacklo_epi8(s, zero4), op4) ;
+				__m128i shi = mul_div255_sse2(_mm_unpackhi_epi8(s, zero4), op4) ;
+				__m128i lo = _mm_add_epi16(mul_div255_sse2(_mm_unpacklo_epi8(d, zero4), alpha_inv_sse2(slo)), slo) ;
+				__m128i hi = _mm_add_epi16(mul_div255_sse2(_mm_unpackhi_epi8(d, zero4), alpha_inv_sse2(shi)), shi) ;
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi)) ;
+			}
+		#endif
+
+			for (; i < n; ++i) {
+				dst[i] = blend_pixel(dst[i], scale_pixel(src[i], opacity)) ;
+			}
+		}
+
+		inline void copy_row(uint32_t* dst, const uint32_t* src, size_t n) noexcept {
+			std::memcpy(dst, src, n * sizeof(uint32_t)) ;
+		}
+	}
+
+	class PixelBuffer {
+	public :
+		static constexpr size_t Alignment = 64 ;
+
+	private :
+		static_assert(Alignment == SurfacePool::Alignment) ;
+
+		// memori milik SurfacePool::Global(), capacity_ = ukuran block dari pool.
+		// capacity_ 0 berarti memori pinjaman (lihat Borrow) dan tidak dilepas.
+		struct PoolDelete__ {
+			size_t capacity_ ;
+
+			void operator()(uint32_t* p) const noexcept {
+				if (capacity_) {
+					SurfacePool::Global().Release(p, capacity_) ;
+				}
+			}
+		} ;
+
+		std::unique_ptr<uint32_t[], PoolDelete__> data_ {} ;
+		uint32_t width_ = 0 ;
+		uint32_t height_ = 0 ;
+		uint32_t stride_ = 0 ;
+
+	public :
+		PixelBuffer(const PixelBuffer&) = delete ;
+		PixelBuffer& operator=(const PixelBuffer&) = delete ;
+		PixelBuffer() = default ;
+
+		PixelBuffer(PixelBuffer&& o) noexcept :
+		data_(std::move(o.data_)),
+		width_(std::exchange(o.width_, 0)),
+		height_(std::exchange(o.height_, 0)),
+		stride_(std::exchange(o.stride_, 0)) {}
+
+		PixelBuffer& operator=(PixelBuffer&& o) noexcept {
+			if (this != &o) {
+				data_ = std::move(o.data_) ;
+				width_ = std::exchange(o.width_, 0) ;
+				height_ = std::exchange(o.height_, 0) ;
+				stride_ = std::exchange(o.stride_, 0) ;
+			}
+			return *this ;
+		}
+
+		// stride dibulatkan ke kelipatan Alignment supaya tiap baris ter-align.
+		// block lama dipakai langsung bila size class-nya sama.
+		bool Create(const Size& size) noexcept {
+			if (size.x == 0 || size.y == 0) {
+				Reset() ;
+				return false ;
+			}
+
+			constexpr uint32_t px_per_align = Alignment / sizeof(uint32_t) ;
+			uint32_t stride = (size.x + px_per_align - 1) / px_per_align * px_per_align ;
+			size_t bytes = static_cast<size_t>(stride) * size.y * sizeof(uint32_t) ;
+
+			if (!data_ || IsBorrowed() || SurfacePool::ClassOf(bytes) != SurfacePool::ClassOf(GetCapacity())) {
+				Reset() ;
+
+				size_t capacity = bytes ;
+				void* mem = SurfacePool::Global().Acquire(capacity) ;
+				if (!mem) {
+					return false ;
+				}
+
+				data_.get_deleter().capacity_ = capacity ;
+				data_.reset(static_cast<uint32_t*>(mem)) ;
+			}
+
+			width_ = size.x ;
+			height_ = size.y ;
+			stride_ = stride ;
+			std::memset(data_.get(), 0, bytes) ;
+			return true ;
+		}
+
+		// ganti ukuran di dalam block yang sudah ada, false bila kapasitasnya kurang.
+		// isi lama tidak dipertahankan.
+		bool Reshape(const Size& size) noexcept {
+			constexpr uint32_t px_per_align = Alignment / sizeof(uint32_t) ;
+			uint32_t stride = (size.x + px_per_align - 1) / px_per_align * px_per_align ;
+			size_t bytes = static_cast<size_t>(stride) * size.y * sizeof(uint32_t) ;
+			if (!data_ || size.x == 0 || size.y == 0 || bytes > GetCapacity()) {
+				return false ;
+			}
+
+			width_ = size.x ;
+			height_ = size.y ;
+			stride_ = stride ;
+			std::memset(data_.get(), 0, bytes) ;
+			return true ;
+		}
+
+		// pakai memori milik orang lain (mis. sub-rect halaman TextureAtlas), stride dalam pixel.
+		// pemilik memori harus hidup lebih lama dari buffer ini. isi tidak diubah.
+		bool Borrow(uint32_t* data, const Size& size, uint32_t stride) noexcept {
+			Reset() ;
+			if (!data || size.x == 0 || size.y == 0 || stride < size.x) {
+				return false ;
+			}
+
+			data_.get_deleter().capacity_ = 0 ;
+			data_.reset(data) ;
+			width_ = size.x ;
+			height_ = size.y ;
+			stride_ = stride ;
+			return true ;
+		}
+
+		void Reset() noexcept {
+			data_.reset() ;
+			width_ = height_ = stride_ = 0 ;
+		}
+
+		bool IsValid() const noexcept { return data_ != nullptr ; }
+		bool IsBorrowed() const noexcept { return data_ && data_.get_deleter().capacity_ == 0 ; }
+
+		uint32_t* GetData() noexcept { return data_.get() ; }
+		const uint32_t* GetData() const noexcept { return data_.get() ; }
+		uint32_t* GetRow(uint32_t y) noexcept { return data_.get() + static_cast<size_t>(y) * stride_ ; }
+		const uint32_t* GetRow(uint32_t y) const noexcept { return data_.get() + static_cast<size_t>(y) * stride_ ; }
+
+		uint32_t GetWidth() const noexcept { return width_ ; }
+		uint32_t GetHeight() const noexcept { return height_ ; }
+		uint32_t GetStride() const noexcept { return stride_ ; }
+		Size GetSize() const noexcept { return {width_, height_} ; }
+		size_t GetByteSize() const noexcept { return static_cast<size_t>(stride_) * height_ * sizeof(uint32_t) ; }
+		size_t GetCapacity() const noexcept { return data_ ? data_.get_deleter().capacity_ : 0 ; }
+	} ;
+
+	// scanline rasterizer tanpa anti-aliasing, sampling di tengah pixel
+	class Rasterizer {
+	private :
+		PixelBuffer* target_ = nullptr ;
+		int32_t clip_x0_ = 0 ;
+		int32_t clip_y0_ = 0 ;
+		int32_t clip_x1_ = 0 ;
+		int32_t clip_y1_ = 0 ;
+		std::vector<float> crossings_ ;
+		std::vector<PointF> stroke_quads_ ;
+		std::vector<std::pair<float, float>> spans_ ;
+
+		// tepi pixel (sampling di tengah) yang dijepit ke [lo, hi] sebelum cast. cast float
+		// ke int untuk NaN / inf / nilai di luar int32 adalah UB, NaN jatuh ke lo
+		static int32_t PixelEdge(float v, int32_t lo, int32_t hi) noexcept {
+			float edge = std::ceil(v - 0.5f) ;
+			if (!(edge > static_cast<float>(lo))) {
+				return lo ;
+			}
+			if (edge >= static_cast<float>(hi)) {
+				return hi ;
+			}
+			return static_cast<int32_t>(edge) ;
+		}
+
+		int32_t EdgeX(float x) const noexcept { return PixelEdge(x, clip_x0_, clip_x1_) ; }
+		int32_t EdgeY(float y) const noexcept { return PixelEdge(y, clip_y0_, clip_y1_) ; }
+
+		void FillSpan(int32_t y, int32_t x0, int32_t x1, uint32_t px) noexcept {
+			x0 = std::max(x0, clip_x0_) ;
+			x1 = std::min(x1, clip_x1_) ;
+			if (x0 >= x1 || y < clip_y0_ || y >= clip_y1_) {
+				return ;
+			}
+
+			uint32_t* row = target_->GetRow(static_cast<uint32_t>(y)) + x0 ;
+			if ((px >> 24) == 0xFF) {
+				span_ops::fill(row, static_cast<size_t>(x1 - x0), px) ;
+			} else {
+				span_ops::blend(row, static_cast<size_t>(x1 - x0), px) ;
+			}
+		}
+
+		void FillSpanF(int32_t y, float left, float right, uint32_t px) noexcept {
+			FillSpan(y, EdgeX(left), EdgeX(right), px) ;
+		}
+
+		// span(yc, left, right) -> bool, dipanggil tiap baris yang kena clip
+		template <typename SpanFn>
+		void FillRows(float top, float bottom, uint32_t px, SpanFn&& span) noexcept {
+			int32_t y0 = EdgeY(top) ;
+			int32_t y1 = EdgeY(bottom) ;
+
+			for (int32_t y = y0; y < y1; ++y) {
+				float left, right ;
+				if (span(static_cast<float>(y) + 0.5f, left, right)) {
+					FillSpanF(y, left, right, px) ;
+				}
+			}
+		}
+
+		// isi area di antara outer dan inner (outline dengan ketebalan)
+		template <typename OuterFn, typename InnerFn>
+		void FillRing(float top, float bottom, uint32_t px, OuterFn&& outer, InnerFn&& inner) noexcept {
+			int32_t y0 = EdgeY(top) ;
+			int32_t y1 = EdgeY(bottom) ;
+
+			for (int32_t y = y0; y < y1; ++y) {
+				float yc = static_cast<float>(y) + 0.5f ;
+				float ol, or_, il, ir ;
+				if (!outer(yc, ol, or_)) {
+					continue ;
+				}
+
+				int32_t x0 = EdgeX(ol) ;
+				int32_t x1 = EdgeX(or_) ;
+				if (inner(yc, il, ir)) {
+					int32_t ix0 = std::max(EdgeX(il), x0) ;
+					int32_t ix1 = std::min(EdgeX(ir), x1) ;
+					if (ix0 < ix1) {
+						FillSpan(y, x0, ix0, px) ;
+						FillSpan(y, ix1, x1, px) ;
+						continue ;
+					}
+				}
+				FillSpan(y, x0, x1, px) ;
+			}
+		}
+
+		static bool RectSpan(const RectF& rc, float yc, float& left, float& right) noexcept {
+			if (rc.w <= 0.0f || rc.h <= 0.0f || yc < rc.y || yc >= rc.y + rc.h) {
+				return false ;
+			}
+			left = rc.x ;
+			right = rc.x + rc.w ;
+			return true ;
+		}
+
+		static bool RoundedSpan(const RectF& rc, float radius, float yc, float& left, float& right) noexcept {
+			if (!RectSpan(rc, yc, left, right)) {
+				return false ;
+			}
+
+			float r = std::clamp(radius, 0.0f, std::min(rc.w, rc.h) / 2.0f) ;
+			float dy = 0.0f ;
+			if (yc < rc.y + r) {
+				dy = rc.y + r - yc ;
+			} else if (yc > rc.y + rc.h - r) {
+				dy = yc - (rc.y + rc.h - r) ;
+			}
+
+			float inset = r - std::sqrt(std::max(r * r - dy * dy, 0.0f)) ;
+			left += inset ;
+			right -= inset ;
+			return left < right ;
+		}
+
+		static bool EllipseSpan(const RectF& rc, float yc, float& left, float& right) noexcept {
+			float rx = rc.w / 2.0f ;
+			float ry = rc.h / 2.0f ;
+			if (rx <= 0.0f || ry <= 0.0f) {
+				return false ;
+			}
+
+			float t = (yc - (rc.y + ry)) / ry ;
+			if (t <= -1.0f || t >= 1.0f) {
+				return false ;
+			}
+
+			float half = rx * std::sqrt(1.0f - t * t) ;
+			left = rc.x + rx - half ;
+			right = rc.x + rx + half ;
+			return true ;
+		}
+
+		static RectF Inflate(const RectF& rc, float d) noexcept {
+			return {rc.x - d, rc.y - d, rc.w + d * 2.0f, rc.h + d * 2.0f} ;
+		}
+
+		// even-odd, sama dengan FillModeAlternate milik GDI+
+		void FillPolygonPx(const PointF* pts, size_t count, uint32_t px) noexcept {
+			if (count < 3) {
+				return ;
+			}
+
+			float top = pts[0].y ;
+			float bottom = pts[0].y ;
+			for (size_t i = 1; i < count; ++i) {
+				top = std::min(top, pts[i].y) ;
+				bottom = std::max(bottom, pts[i].y) ;
+			}
+
+			int32_t y0 = EdgeY(top) ;
+			int32_t y1 = EdgeY(bottom) ;
+
+			for (int32_t y = y0; y < y1; ++y) {
+				float yc = static_cast<float>(y) + 0.5f ;
+				crossings_.clear() ;
+
+				for (size_t i = 0, j = count - 1; i < count; j = i++) {
+					const PointF& a = pts[j] ;
+					const PointF& b = pts[i] ;
+					if ((a.y <= yc && b.y > yc) || (b.y <= yc && a.y > yc)) {
+						crossings_.push_back(a.x + (yc - a.y) * (b.x - a.x) / (b.y - a.y)) ;
+					}
+				}
+
+				std::sort(crossings_.begin(), crossings_.end()) ;
+				for (size_t k = 0; k + 1 < crossings_.size(); k += 2) {
+					FillSpanF(y, crossings_[k], crossings_[k + 1], px) ;
+				}
+			}
+		}
+
+		// quad stroke segmen start -> end dengan setengah tebal half
+		static void StrokeQuad(const PointF& start, const PointF& end, float half, PointF* quad) noexcept {
+			float dx = end.x - start.x ;
+			float dy = end.y - start.y ;
+			float len = std::sqrt(dx * dx + dy * dy) ;
+
+			if (len <= 0.0f) {
+				quad[0] = {start.x - half, start.y - half} ;
+				quad[1] = {start.x + half, start.y - half} ;
+				quad[2] = {start.x + half, start.y + half} ;
+				quad[3] = {start.x - half, start.y + half} ;
+				return ;
+			}
+
+			float nx = -dy / len * half ;
+			float ny = dx / len * half ;
+			quad[0] = {start.x + nx, start.y + ny} ;
+			quad[1] = {end.x + nx, end.y + ny} ;
+			quad[2] = {end.x - nx, end.y - ny} ;
+			quad[3] = {start.x - nx, start.y - ny} ;
+		}
+
+		// gabungan (union) quad konveks : span tiap quad per baris digabung dulu sebelum
+		// diisi, jadi area yang tumpang tindih (sambungan polyline) hanya di-blend sekali
+		void FillQuadUnion(const PointF* quads, size_t quad_count, uint32_t px) noexcept {
+			if (quad_count == 0) {
+				return ;
+			}
+
+			float top = quads[0].y ;
+			float bottom = quads[0].y ;
+			for (size_t i = 1; i < quad_count * 4; ++i) {
+				top = std::min(top, quads[i].y) ;
+				bottom = std::max(bottom, quads[i].y) ;
+			}
+
+			int32_t y0 = EdgeY(top) ;
+			int32_t y1 = EdgeY(bottom) ;
+
+			for (int32_t y = y0; y < y1; ++y) {
+				float yc = static_cast<float>(y) + 0.5f ;
+				spans_.clear() ;
+
+				for (size_t q = 0; q < quad_count; ++q) {
+					const PointF* pts = quads + q * 4 ;
+					float left = std::numeric_limits<float>::max() ;
+					float right = std::numeric_limits<float>::lowest() ;
+					for (size_t i = 0, j = 3; i < 4; j = i++) {
+						const PointF& a = pts[j] ;
+						const PointF& b = pts[i] ;
+						if ((a.y <= yc && b.y > yc) || (b.y <= yc && a.y > yc)) {
+							float x = a.x + (yc - a.y) * (b.x - a.x) / (b.y - a.y) ;
+							left = std::min(left, x) ;
+							right = std::max(right, x) ;
+						}
+					}
+
+					if (left < right) {
+						spans_.emplace_back(left, right) ;
+					}
+				}
+
+				std::sort(spans_.begin(), spans_.end()) ;
+				for (size_t k = 0; k < spans_.size();) {
+					float left = spans_[k].first ;
+					float right = spans_[k].second ;
+					for (++k; k < spans_.size() && spans_[k].first <= right; ++k) {
+						right = std::max(right, spans_[k].second) ;
+					}
+					FillSpanF(y, left, right, px) ;
+				}
+			}
+		}
+
+		void StrokeLine(const PointF& start, const PointF& end, uint32_t px, float thickness) noexcept {
+			PointF quad[4] ;
+			StrokeQuad(start, end, std::max(thickness, 1.0f) / 2.0f, quad) ;
+			FillQuadUnion(quad, 1, px) ;
+		}
+
+	public :
+		Rasterizer() = default ;
+
+		void Bind(PixelBuffer& target) noexcept {
+			target_ = &target ;
+			ResetClip() ;
+		}
+
+		void Unbind() noexcept {
+			target_ = nullptr ;
+			clip_x0_ = clip_y0_ = clip_x1_ = clip_y1_ = 0 ;
+		}
+
+		// clip selalu dipotong ke ukuran target
+		void SetClip(const Rect& clip) noexcept {
+			if (!target_) {
+				return ;
+			}
+
+			clip_x0_ = std::max(clip.x, 0) ;
+			clip_y0_ = std::max(clip.y, 0) ;
+			clip_x1_ = static_cast<int32_t>(std::min<int64_t>(static_cast<int64_t>(clip.x) + clip.w, target_->GetWidth())) ;
+			clip_y1_ = static_cast<int32_t>(std::min<int64_t>(static_cast<int64_t>(clip.y) + clip.h, target_->GetHeight())) ;
+		}
+
+		void ResetClip() noexcept {
+			if (!target_) {
+				return ;
+			}
+
+			clip_x0_ = clip_y0_ = 0 ;
+			clip_x1_ = static_cast<int32_t>(target_->GetWidth()) ;
+			clip_y1_ = static_cast<int32_t>(target_->GetHeight()) ;
+		}
+
+		Rect GetClip() const noexcept {
+			return {clip_x0_, clip_y0_, std::max(clip_x1_ - clip_x0_, 0), std::max(clip_y1_ - clip_y0_, 0)} ;
+		}
+
+		bool IsBound() const noexcept { return target_ && target_->IsValid() ; }
+
+		// copy, bukan blend : alpha warna ikut ditulis apa adanya
+		void Clear(const Color& color) noexcept {
+			if (!IsBound()) {
+				return ;
+			}
+
+			uint32_t px = ToPixel(color) ;
+			for (int32_t y = clip_y0_; y < clip_y1_; ++y) {
+				if (clip_x0_ < clip_x1_) {
+					span_ops::fill(target_->GetRow(static_cast<uint32_t>(y)) + clip_x0_, static_cast<size_t>(clip_x1_ - clip_x0_), px) ;
+				}
+			}
+		}
+
+		void FillRect(const RectF& rect, const Color& color) noexcept {
+			if (!IsBound()) {
+				return ;
+			}
+
+			FillRows(rect.y, rect.y + rect.h, ToPixel(color), [&](float yc, float& l, float& r) {
+				return RectSpan(rect, yc, l, r) ;
+			}) ;
+		}
+
+		void DrawRect(const RectF& rect, const Color& color, float thickness = 1.0f) noexcept {
+			if (!IsBound()) {
+				return ;
+			}
+
+			float half = std::max(thickness, 1.0f) / 2.0f ;
+			RectF outer = Inflate(rect, half) ;
+			RectF inner = Inflate(rect, -half) ;
+			FillRing(outer.y, outer.y + outer.h, ToPixel(color),
+				[&](float yc, float& l, float& r) { return RectSpan(outer, yc, l, r) ; },
+				[&](float yc, float& l, float& r) { return RectSpan(inner, yc, l, r) ; }) ;
+		}
+
+		void FillRectRounded(const RectF& rect, const Color& color, float radius) noexcept {
+			if (!IsBound()) {
+				return ;
+			}
+
+			FillRows(rect.y, rect.y + rect.h, ToPixel(color), [&](float yc, float& l, float& r) {
+				return RoundedSpan(rect, radius, yc, l, r) ;
+			}) ;
+		}
+
+		void DrawRectRounded(const RectF& rect, const Color& color, float radius, float thickness = 1.0f) noexcept {
+			if (!IsBound()) {
+				return ;
+			}
+
+			float half = std::max(thickness, 1.0f) / 2.0f ;
+			RectF outer = Inflate(rect, half) ;
+			RectF inner = Inflate(rect, -half) ;
+			float inner_radius = std::max(radius - half, 0.0f) ;
+			FillRing(outer.y, outer.y + outer.h, ToPixel(color),
+				[&](float yc, float& l, float& r) { return RoundedSpan(outer, radius + half, yc, l, r) ; },
+				[&](float yc, float& l, float& r) { return RoundedSpan(inner, inner_radius, yc, l, r) ; }) ;
+		}
+
+		void FillEllipse(const RectF& rect, const Color& color) noexcept {
+			if (!IsBound()) {
+				return ;
+			}
+
+			FillRows(rect.y, rect.y + rect.h, ToPixel(color), [&](float yc, float& l, float& r) {
+				return EllipseSpan(rect, yc, l, r) ;
+			}) ;
+		}
+
+		void DrawEllipse(const RectF& rect, const Color& color, float thickness = 1.0f) noexcept {
+			if (!IsBound()) {
+				return ;
+			}
+
+			float half = std::max(thickness, 1.0f) / 2.0f ;
+			RectF outer = Inflate(rect, half) ;
+			RectF inner = Inflate(rect, -half) ;
+			FillRing(outer.y, outer.y + outer.h, ToPixel(color),
+				[&](float yc, float& l, float& r) { return EllipseSpan(outer, yc, l, r) ; },
+				[&](float yc, float& l, float& r) { return EllipseSpan(inner, yc, l, r) ; }) ;
+		}
+
+		void FillPolygon(const PointF* points, size_t count, const Color& color) noexcept {
+			if (!IsBound() || !points) {
+				return ;
+			}
+
+			FillPolygonPx(points, count, ToPixel(color)) ;
+		}
+
+		void FillPolygon(const Vertex& vertices, const Color& color) noexcept {
+			FillPolygon(vertices.data(), vertices.size(), color) ;
+		}
+
+		void DrawPolygon(const PointF* points, size_t count, const Color& color, float thickness = 1.0f) noexcept {
+			if (!IsBound() || !points || count < 2) {
+				return ;
+			}
+
+			// semua segmen diisi sebagai satu gabungan, sudut tidak di-blend dua kali
+			float half = std::max(thickness, 1.0f) / 2.0f ;
+			stroke_quads_.resize(count * 4) ;
+			for (size_t i = 0, j = count - 1; i < count; j = i++) {
+				StrokeQuad(points[j], points[i], half, &stroke_quads_[i * 4]) ;
+			}
+			FillQuadUnion(stroke_quads_.data(), count, ToPixel(color)) ;
+		}
+
+		void DrawPolygon(const Vertex& vertices, const Color& color, float thickness = 1.0f) noexcept {
+			DrawPolygon(vertices.data(), vertices.size(), color, thickness) ;
+		}
+
+		void DrawLine(const PointF& start, const PointF& end, const Color& color, float thickness = 1.0f) noexcept {
+			if (!IsBound()) {
+				return ;
+			}
+
+			StrokeLine(start, end, ToPixel(color), thickness) ;
+		}
+
+		// source-over dari buffer premultiplied lain (stride dalam pixel)
+		void Blit(const uint32_t* src, uint32_t src_stride, const Size& size, const Point& pos) noexcept {
+			if (!IsBound() || !src) {
+				return ;
+			}
+
+			int32_t x0 = std::max(pos.x, clip_x0_) ;
+			int32_t y0 = std::max(pos.y, clip_y0_) ;
+			int32_t x1 = static_cast<int32_t>(std::min<int64_t>(static_cast<int64_t>(pos.x) + size.x, clip_x1_)) ;
+			int32_t y1 = static_cast<int32_t>(std::min<int64_t>(static_cast<int64_t>(pos.y) + size.y, clip_y1_)) ;
+			if (x0 >= x1 || y0 >= y1) {
+				return ;
+			}
+
+			for (int32_t y = y0; y < y1; ++y) {
+				const uint32_t* src_row = src + static_cast<size_t>(y - pos.y) * src_stride + (x0 - pos.x) ;
+				span_ops::blend_row(target_->GetRow(static_cast<uint32_t>(y)) + x0, src_row, static_cast<size_t>(x1 - x0)) ;
+			}
+		}
+
+		void Blit(const PixelBuffer& src, const Point& pos) noexcept {
+			Blit(src.GetData(), src.GetStride(), src.GetSize(), pos) ;
+		}
+
+		PixelBuffer* GetTarget() const noexcept { return target_ ; }
+	} ;
+}
\ No newline at end of file
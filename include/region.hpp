@@ -0,0 +1,172 @@
+#pragma once
+#include "unit.hpp"
+
+namespace zketch {
+
+	// kosong (w = h = 0) bila tidak beririsan
+	inline Rect IntersectRect(const Rect& a, const Rect& b) noexcept {
+		int64_t x0 = std::max<int64_t>(a.x, b.x) ;
+		int64_t y0 = std::max<int64_t>(a.y, b.y) ;
+		int64_t x1 = std::min<int64_t>(static_cast<int64_t>(a.x) + a.w, static_cast<int64_t>(b.x) + b.w) ;
+		int64_t y1 = std::min<int64_t>(static_cast<int64_t>(a.y) + a.h, static_cast<int64_t>(b.y) + b.h) ;
+		if (x1 <= x0 || y1 <= y0) {
+			return {} ;
+		}
+		return Rect(static_cast<int32_t>(x0), static_cast<int32_t>(y0), static_cast<uint32_t>(x1 - x0), static_cast<uint32_t>(y1 - y0)) ;
+	}
+
+	inline bool ContainsRect(const Rect& outer, const Rect& inner) noexcept {
+		return inner.w == 0 || inner.h == 0 || (
+			inner.x >= outer.x && inner.y >= outer.y &&
+			static_cast<int64_t>(inner.x) + inner.w <= static_cast<int64_t>(outer.x) + outer.w &&
+			static_cast<int64_t>(inner.y) + inner.h <= static_cast<int64_t>(outer.y) + outer.h
+		) ;
+	}
+
+	// kumpulan rect yang saling lepas (disjoint). rect yang bersentuhan / overlap digabung,
+	// dan bila jumlahnya melewati kapasitas region disederhanakan jadi bounding box.
+	class DamageRegion {
+	private :
+		struct Edges {
+			int64_t x0, y0, x1, y1 ;
+
+			static constexpr Edges From(const Rect& r) noexcept {
+				return {r.x, r.y, static_cast<int64_t>(r.x) + r.w, static_cast<int64_t>(r.y) + r.h} ;
+			}
+
+			constexpr Rect ToRect() const noexcept {
+				return Rect(static_cast<int32_t>(x0), static_cast<int32_t>(y0), static_cast<uint32_t>(x1 - x0), static_cast<uint32_t>(y1 - y0)) ;
+			}
+
+			constexpr uint64_t Area() const noexcept {
+				return static_cast<uint64_t>(x1 - x0) * static_cast<uint64_t>(y1 - y0) ;
+			}
+
+			constexpr bool Touches(const Edges& o) const noexcept {
+				return x0 <= o.x1 && o.x0 <= x1 && y0 <= o.y1 && o.y0 <= y1 ;
+			}
+
+			constexpr bool Contains(const Edges& o) const noexcept {
+				return x0 <= o.x0 && y0 <= o.y0 && x1 >= o.x1 && y1 >= o.y1 ;
+			}
+
+			constexpr Edges Union(const Edges& o) const noexcept {
+				return {std::min(x0, o.x0), std::min(y0, o.y0), std::max(x1, o.x1), std::max(y1, o.y1)} ;
+			}
+		} ;
+
+		std::vector<Rect> rects_ ;
+		Rect bounds_ {} ;
+		size_t capacity_ = DefaultCapacity ;
+		bool collapsed_ = false ;
+
+		void Collapse() noexcept {
+			rects_.clear() ;
+			rects_.push_back(bounds_) ;
+			collapsed_ = true ;
+		}
+
+	public :
+		static constexpr size_t DefaultCapacity = 16 ;
+
+		DamageRegion() = default ;
+		explicit DamageRegion(size_t capacity) noexcept : capacity_(capacity ? capacity : 1) {}
+
+		void Add(const Rect& rect) noexcept {
+			if (rect.w == 0 || rect.h == 0) {
+				return ;
+			}
+
+			Edges add = Edges::From(rect) ;
+
+			if (rects_.empty()) {
+				bounds_ = rect ;
+			} else {
+				bounds_ = Edges::From(bounds_).Union(add).ToRect() ;
+			}
+
+			if (collapsed_) {
+				rects_.front() = bounds_ ;
+				return ;
+			}
+
+			// gabung dengan semua rect yang overlap / bersentuhan sampai tidak ada lagi.
+			// gabungan juga diambil bila luasnya tidak lebih besar dari jumlah keduanya
+			// ditambah 1/4, supaya potongan kecil berdampingan tidak memecah region.
+			for (size_t i = 0; i < rects_.size();) {
+				Edges cur = Edges::From(rects_[i]) ;
+				if (cur.Contains(add)) {
+					return ;
+				}
+
+				Edges merged = cur.Union(add) ;
+				uint64_t separate = cur.Area() + add.Area() ;
+				if (cur.Touches(add) || merged.Area() <= separate + separate / 4) {
+					add = merged ;
+					rects_[i] = rects_.back() ;
+					rects_.pop_back() ;
+					i = 0 ;
+					continue ;
+				}
+
+				++i ;
+			}
+
+			rects_.push_back(add.ToRect()) ;
+			if (rects_.size() > capacity_) {
+				Collapse() ;
+			}
+		}
+
+		// hanya bagian rect yang berada di dalam clip yang ditambahkan
+		void Add(const Rect& rect, const Rect& clip) noexcept {
+			Edges a = Edges::From(rect) ;
+			Edges c = Edges::From(clip) ;
+			Edges r {std::max(a.x0, c.x0), std::max(a.y0, c.y0), std::min(a.x1, c.x1), std::min(a.y1, c.y1)} ;
+			if (r.x1 <= r.x0 || r.y1 <= r.y0) {
+				return ;
+			}
+
+			Add(r.ToRect()) ;
+		}
+
+		void Clear() noexcept {
+			rects_.clear() ;
+			bounds_ = Rect{} ;
+			collapsed_ = false ;
+		}
+
+		void SetCapacity(size_t capacity) noexcept {
+			capacity_ = capacity ? capacity : 1 ;
+			if (rects_.size() > capacity_) {
+				Collapse() ;
+			}
+		}
+
+		bool Intersects(const Rect& rect) const noexcept {
+			Edges e = Edges::From(rect) ;
+			for (const auto& r : rects_) {
+				Edges o = Edges::From(r) ;
+				if (o.x0 < e.x1 && e.x0 < o.x1 && o.y0 < e.y1 && e.y0 < o.y1) {
+					return true ;
+				}
+			}
+			return false ;
+		}
+
+		// rect selalu disjoint jadi jumlah luas = luas region
+		uint64_t GetArea() const noexcept {
+			uint64_t area = 0 ;
+			for (const auto& r : rects_) {
+				area += static_cast<uint64_t>(r.w) * r.h ;
+			}
+			return area ;
+		}
+
+		bool IsEmpty() const noexcept { return rects_.empty() ; }
+		bool IsCollapsed() const noexcept { return collapsed_ ; }
+		size_t GetCapacity() const noexcept { return capacity_ ; }
+		const Rect& GetBounds() const noexcept { return bounds_ ; }
+		const std::vector<Rect>& GetRects() const noexcept { return rects_ ; }
+	} ;
+}
\ No newline at end of file
@@ -1,16 +1,44 @@
 #pragma once
-#include "window.hpp"
+#include "canvas.hpp"
+#include "displaylist.hpp"
+#include "paintcache.hpp"
+#include "geometry.hpp"
+#include "fontmetrics.hpp"
+#include "tilerasterizer.hpp"
+
+#ifdef ZKETCH_WIN32
+	#include "window.hpp"
+#endif
 
 namespace zketch {
 
 	class Renderer {
 	private :
+	#ifdef ZKETCH_WIN32
 		std::unique_ptr<Gdiplus::Graphics> gfx_ {} ;
+	#endif
+		Rasterizer raster_ {} ;
 		Canvas* canvas_target_ = nullptr ;
 		Window* window_target_ = nullptr ;
+		DisplayList* record_target_ = nullptr ;
+		const Canvas* retain_src_ = nullptr ;
+		const DamageRegion* retain_region_ = nullptr ;
 		bool is_drawing_ = false ;
+		bool software_ = false ;
+
+		bool HasBackend() const noexcept {
+			#ifdef ZKETCH_WIN32
+				return software_ || gfx_ ;
+			#else
+				return software_ ;
+			#endif
+		}
 
 		bool IsValid() const noexcept {
+			if (record_target_) {
+				return is_drawing_ ;
+			}
+
 			if (!canvas_target_) {
 
 				#ifdef RENDERER_DEBUG
@@ -20,8 +48,8 @@ namespace zketch {
 				return false ;
 			}
 
-			if (!gfx_ || !is_drawing_) {
-				if (!gfx_) {
+			if (!HasBackend() || !is_drawing_) {
+				if (!HasBackend()) {
 
 					#ifdef RENDERER_DEBUG
 						logger::warning("Renderer::IsValid - gfx is null!") ;
@@ -42,14 +70,302 @@ namespace zketch {
 			return true ;
 		}
 
+		// salin area dari canvas lain berukuran sama tanpa blending
+		void CopyArea(const Canvas& src, const Rect& area) noexcept {
+			if (software_) {
+				PixelBuffer* dst = canvas_target_->GetPixels() ;
+				if (const PixelBuffer* pixels = src.GetPixels()) {
+					for (uint32_t y = 0; y < area.h; ++y) {
+						span_ops::copy_row(dst->GetRow(area.y + y) + area.x, pixels->GetRow(area.y + y) + area.x, area.w) ;
+					}
+					return ;
+				}
+
+				#ifdef ZKETCH_WIN32
+					Gdiplus::BitmapData data ;
+					Gdiplus::Rect lock(area.x, area.y, static_cast<INT>(area.w), static_cast<INT>(area.h)) ;
+					if (src.GetBitmap()->LockBits(&lock, Gdiplus::ImageLockModeRead, PixelFormat32bppPARGB, &data) == Gdiplus::Ok) {
+						for (uint32_t y = 0; y < area.h; ++y) {
+							const auto* row = reinterpret_cast<const uint32_t*>(static_cast<const BYTE*>(data.Scan0) + static_cast<size_t>(y) * data.Stride) ;
+							span_ops::copy_row(dst->GetRow(area.y + y) + area.x, row, area.w) ;
+						}
+						src.GetBitmap()->UnlockBits(&data) ;
+					}
+				#endif
+
+				return ;
+			}
+
+			#ifdef ZKETCH_WIN32
+				auto prevMode = gfx_->GetCompositingMode() ;
+				gfx_->SetCompositingMode(Gdiplus::CompositingModeSourceCopy) ;
+				gfx_->DrawImage(src.GetBitmap(), area.x, area.y, area.x, area.y, static_cast<INT>(area.w), static_cast<INT>(area.h), Gdiplus::UnitPixel) ;
+				gfx_->SetCompositingMode(prevMode) ;
+			#endif
+		}
+
+		// dijalankan tepat sebelum primitive pertama yang menggambar (lihat Begin dengan previous)
+		void ResolveRetain() noexcept {
+			if (!retain_src_) {
+				return ;
+			}
+
+			const Canvas* src = std::exchange(retain_src_, nullptr) ;
+			const DamageRegion* region = std::exchange(retain_region_, nullptr) ;
+			if (!src->IsValid() || src->GetSize() != canvas_target_->GetSize()) {
+				return ;
+			}
+
+			for (const auto& r : region->GetRects()) {
+				CopyArea(*src, r) ;
+				if (!ContainsRect(src->GetOpaqueRect(), IntersectRect(r, canvas_target_->GetOpaqueRect()))) {
+					canvas_target_->ClearOpaque(r) ;
+				}
+			}
+
+			// area yang disalin sudah sama dengan yang tampil, yang diwarisi hanya damage
+			// sumber yang belum di-present
+			for (const auto& r : src->GetDamage().GetRects()) {
+				canvas_target_->MarkInvalidate(r) ;
+			}
+		}
+
+		// bounds dibulatkan keluar, +1 pixel untuk antialias GDI+
+		void MarkDamage(const RectF& bounds, float grow = 0.0f) noexcept {
+			ResolveRetain() ;
+
+			constexpr float limit = 1.0e9f ;
+			float pad = grow + 1.0f ;
+			float l = std::min(bounds.x, bounds.x + bounds.w) - pad ;
+			float t = std::min(bounds.y, bounds.y + bounds.h) - pad ;
+			float r = std::max(bounds.x, bounds.x + bounds.w) + pad ;
+			float b = std::max(bounds.y, bounds.y + bounds.h) + pad ;
+			int32_t x0 = static_cast<int32_t>(std::floor(std::clamp(l, -limit, limit))) ;
+			int32_t y0 = static_cast<int32_t>(std::floor(std::clamp(t, -limit, limit))) ;
+			int32_t x1 = static_cast<int32_t>(std::ceil(std::clamp(r, -limit, limit))) ;
+			int32_t y1 = static_cast<int32_t>(std::ceil(std::clamp(b, -limit, limit))) ;
+			canvas_target_->MarkInvalidate(Rect(x0, y0, static_cast<uint32_t>(x1 - x0), static_cast<uint32_t>(y1 - y0))) ;
+		}
+
+		// padanan pencatatan opaque Clear / FillRect untuk list yang tidak lewat method-nya
+		void TrackOpaque(const DisplayList& list) noexcept {
+			using DL = DisplayList ;
+			list.ForEach([this](DrawOp op, const std::byte* data) {
+				if (op == DrawOp::Clear) {
+					if (Color(DL::Read<DL::ClearCmd>(data).color_).GetA() == 255) {
+						canvas_target_->MarkOpaque(Rect{0, 0, canvas_target_->GetWidth(), canvas_target_->GetHeight()}) ;
+					} else {
+						canvas_target_->ClearOpaque() ;
+					}
+				} else if (op == DrawOp::FillRect) {
+					auto cmd = DL::Read<DL::ShapeCmd>(data) ;
+					if (Color(cmd.color_).GetA() == 255) {
+						canvas_target_->MarkOpaque(static_cast<Rect>(cmd.rect_)) ;
+					}
+				}
+			}) ;
+		}
+
+		// koordinat NaN / inf ditolak sebelum sampai ke rasterizer / GDI+
+		static bool IsFinite(const RectF& rect) noexcept {
+			return std::isfinite(rect.x) && std::isfinite(rect.y) && std::isfinite(rect.w) && std::isfinite(rect.h) ;
+		}
+
+		static bool IsFinite(const PointF* points, size_t count) noexcept {
+			for (size_t i = 0; i < count; ++i) {
+				if (!std::isfinite(points[i].x) || !std::isfinite(points[i].y)) {
+					return false ;
+				}
+			}
+			return true ;
+		}
+
+		static RectF PointsBound(const PointF* points, size_t count) noexcept {
+			float l = points[0].x, t = points[0].y, r = l, b = t ;
+			for (size_t i = 1; i < count; ++i) {
+				l = std::min(l, points[i].x) ;
+				t = std::min(t, points[i].y) ;
+				r = std::max(r, points[i].x) ;
+				b = std::max(b, points[i].y) ;
+			}
+			return {l, t, r - l, b - t} ;
+		}
+
+	#ifdef ZKETCH_WIN32
+		// outline dari GeometryCache digeser ke posisi rect ke buffer scratch per thread
+		static const std::vector<Gdiplus::PointF>& TranslateOutline(const Vertex& outline, float dx, float dy) noexcept {
+			static thread_local std::vector<Gdiplus::PointF> scratch ;
+			scratch.resize(outline.size()) ;
+			for (size_t i = 0; i < outline.size(); ++i) {
+				scratch[i] = Gdiplus::PointF(outline[i].x + dx, outline[i].y + dy) ;
+			}
+			return scratch ;
+		}
+
+		static void DrawStringTo(Gdiplus::Graphics& gfx, const Canvas* target, const wchar_t* text, size_t length, const Point& pos, const Color& color, const Font& font) noexcept {
+			Gdiplus::SolidBrush* brush = PaintCache::ForThread().GetBrush(color) ;
+			Gdiplus::Font used_font = font ;
+			gfx.SetTextRenderingHint(Gdiplus::TextRenderingHintAntiAliasGridFit) ;
+			Gdiplus::RectF layout(static_cast<Gdiplus::REAL>(pos.x), static_cast<Gdiplus::REAL>(pos.y), static_cast<Gdiplus::REAL>(target ? target->GetWidth() - pos.x : 0), static_cast<Gdiplus::REAL>(target ? target->GetHeight() - pos.y : 0));
+			Gdiplus::StringFormat fmt ;
+			fmt.SetAlignment(Gdiplus::StringAlignmentNear) ;
+			fmt.SetLineAlignment(Gdiplus::StringAlignmentNear) ;
+			gfx.DrawString(text, static_cast<INT>(length), &used_font, layout, &fmt, brush) ;
+		}
+	#endif
+
+		void DrawStringImpl(const wchar_t* text, size_t length, const Point& pos, const Color& color, const Font& font) noexcept {
+			if (!IsValid()) {
+				return ;
+			}
+
+			if (!text || length == 0) {
+
+				#ifdef RENDERER_DEBUG
+					logger::warning("Renderer::DrawString - Text is empty") ;
+				#endif
+
+				return ;
+			}
+
+			if (record_target_) {
+				record_target_->PushString(text, length, pos, color, font) ;
+				return ;
+			}
+
+			// layout teks membentang sampai tepi canvas
+			MarkDamage(RectF{static_cast<float>(pos.x), static_cast<float>(pos.y), static_cast<float>(canvas_target_->GetWidth()) - pos.x, static_cast<float>(canvas_target_->GetHeight()) - pos.y}) ;
+
+			// rasterizer software belum punya text engine, teks tetap lewat GDI+
+			// yang menggambar langsung ke memori canvas. headless : tidak digambar.
+			#ifdef ZKETCH_WIN32
+				if (software_) {
+					Gdiplus::Graphics gfx(canvas_target_->GetBitmap()) ;
+					DrawStringTo(gfx, canvas_target_, text, length, pos, color, font) ;
+					return ;
+				}
+
+				DrawStringTo(*gfx_, canvas_target_, text, length, pos, color, font) ;
+			#endif
+		}
+
+		void DrawPolygonImpl(const PointF* points, size_t count, const Color& color, float thickness) noexcept {
+			if (!IsValid()) {
+				return ;
+			}
+
+			if (!points || count == 0) {
+
+				#ifdef RENDERER_DEBUG
+					logger::warning("Renderer::DrawPolygon - Vertices is Empty") ;
+				#endif
+
+				return ;
+			}
+
+			if (!std::isfinite(thickness) || thickness < 0.0f) {
+
+				#ifdef RENDERER_DEBUG
+					logger::warning("Renderer::DrawPolygon - Thickness lower than 0.0 or not finite") ;
+				#endif
+
+				return ;
+			}
+
+			if (!IsFinite(points, count)) {
+
+				#ifdef RENDERER_DEBUG
+					logger::warning("Renderer::DrawPolygon - Vertices not finite") ;
+				#endif
+
+				return ;
+			}
+
+			if (record_target_) {
+				record_target_->PushPolygon(DrawOp::DrawPolygon, points, count, color, thickness) ;
+				return ;
+			}
+
+			// miter join GDI+ (limit 10) bisa menjulur sampai 5x thickness
+			MarkDamage(PointsBound(points, count), thickness * 5.0f) ;
+			if (software_) {
+				raster_.DrawPolygon(points, count, color, thickness) ;
+				return ;
+			}
+
+			#ifdef ZKETCH_WIN32
+				std::vector<Gdiplus::PointF> gdi_points ;
+				gdi_points.reserve(count) ;
+
+				for (size_t i = 0; i < count; ++i) {
+					gdi_points.emplace_back(points[i].x, points[i].y) ;
+				}
+
+				Gdiplus::Pen* p = PaintCache::ForThread().GetPen(color, thickness) ;
+				gfx_->DrawPolygon(p, gdi_points.data(), static_cast<int>(gdi_points.size())) ;
+			#endif
+		}
+
+		void FillPolygonImpl(const PointF* points, size_t count, const Color& color) noexcept {
+			if (!IsValid()) {
+				return ;
+			}
+
+			if (!points || count == 0) {
+
+				#ifdef RENDERER_DEBUG
+					logger::warning("Renderer::FillPolygon - Vertices is Empty") ;
+				#endif
+
+				return ;
+			}
+
+			if (!IsFinite(points, count)) {
+
+				#ifdef RENDERER_DEBUG
+					logger::warning("Renderer::FillPolygon - Vertices not finite") ;
+				#endif
+
+				return ;
+			}
+
+			if (record_target_) {
+				record_target_->PushPolygon(DrawOp::FillPolygon, points, count, color) ;
+				return ;
+			}
+
+			MarkDamage(PointsBound(points, count)) ;
+			if (software_) {
+				raster_.FillPolygon(points, count, color) ;
+				return ;
+			}
+
+			#ifdef ZKETCH_WIN32
+				std::vector<Gdiplus::PointF> gdi_points ;
+				gdi_points.reserve(count) ;
+			
+				for (size_t i = 0; i < count; ++i) {
+					gdi_points.emplace_back(points[i].x, points[i].y) ;
+				}
+
+				Gdiplus::SolidBrush* b = PaintCache::ForThread().GetBrush(color) ;
+				gfx_->FillPolygon(b, gdi_points.data(), static_cast<int>(gdi_points.size())) ;
+			#endif
+		}
+
 	public :
 		Renderer(const Renderer&) = delete ;
 		Renderer& operator=(const Renderer&) = delete ;
 		Renderer() = default ;
 
 		Renderer(Renderer&& o) noexcept : 
-		gfx_(std::move(o.gfx_)), canvas_target_(std::exchange(o.canvas_target_, nullptr)), 
-		is_drawing_(std::exchange(o.is_drawing_, false)) {}
+	#ifdef ZKETCH_WIN32
+		gfx_(std::move(o.gfx_)), 
+	#endif
+		raster_(std::move(o.raster_)), canvas_target_(std::exchange(o.canvas_target_, nullptr)), 
+		window_target_(std::exchange(o.window_target_, nullptr)), record_target_(std::exchange(o.record_target_, nullptr)), 
+		retain_src_(std::exchange(o.retain_src_, nullptr)), retain_region_(std::exchange(o.retain_region_, nullptr)), 
+		is_drawing_(std::exchange(o.is_drawing_, false)), software_(std::exchange(o.software_, false)) {}
 
 		Renderer& operator=(Renderer&& o) noexcept {
 			if (this != &o) {
@@ -57,9 +373,18 @@ namespace zketch {
 					End() ;
 				} 
 
-				gfx_ = std::move(o.gfx_) ;
+				#ifdef ZKETCH_WIN32
+					gfx_ = std::move(o.gfx_) ;
+				#endif
+
+				raster_ = std::move(o.raster_) ;
 				canvas_target_ = std::exchange(o.canvas_target_, nullptr) ;
+				window_target_ = std::exchange(o.window_target_, nullptr) ;
+				record_target_ = std::exchange(o.record_target_, nullptr) ;
+				retain_src_ = std::exchange(o.retain_src_, nullptr) ;
+				retain_region_ = std::exchange(o.retain_region_, nullptr) ;
 				is_drawing_ = std::exchange(o.is_drawing_, false) ;
+				software_ = std::exchange(o.software_, false) ;
 			}
 
 			return *this ;
@@ -95,6 +420,15 @@ namespace zketch {
 				return false ;
 			}
 
+			if (src.IsSoftware()) {
+				raster_.Bind(*src.GetPixels()) ;
+				canvas_target_ = &src ;
+				software_ = true ;
+				is_drawing_ = true ;
+				return true ;
+			}
+
+		#ifdef ZKETCH_WIN32
 			auto* bmp = src.GetBitmap() ;
 			if (!bmp) {
 				#ifdef RENDERER_DEBUG
@@ -131,9 +465,29 @@ namespace zketch {
 			gfx_->SetCompositingQuality(Gdiplus::CompositingQualityHighSpeed) ;
 			gfx_->SetCompositingMode(Gdiplus::CompositingModeSourceOver) ;
 
+			return true ;
+		#else
+			return false ;
+		#endif
+		}
+
+		// target diawali dengan isi previous pada area changed. penyalinan ditunda sampai
+		// primitive pertama dan dilewati bila primitive pertama adalah Clear.
+		// previous dan changed harus tetap hidup sampai End().
+		bool Begin(Canvas& target, const Canvas& previous, const DamageRegion& changed) noexcept {
+			if (!Begin(target)) {
+				return false ;
+			}
+
+			if (&previous != &target && !changed.IsEmpty()) {
+				retain_src_ = &previous ;
+				retain_region_ = &changed ;
+			}
+
 			return true ;
 		}
 
+	#ifdef ZKETCH_WIN32
 		bool Begin(Window& window) noexcept {
 			if (is_drawing_) {
 
@@ -153,74 +507,102 @@ namespace zketch {
 				return false ;
 			}
 
-			auto* bmp = window.back_buffer_->GetBitmap() ;
-			if (!bmp) {
-				#ifdef RENDERER_DEBUG
-					logger::error("Renderer::Begin - source bitmap is null!") ;
-				#endif
-
+			if (!Begin(*window.back_buffer_, *window.front_buffer_, window.frame_damage_)) {
 				return false ;
 			}
 
-			gfx_ = std::make_unique<Gdiplus::Graphics>(bmp) ;
-			if (!gfx_) {
-				#ifdef RENDERER_DEBUG
-					logger::error("Renderer::Begin - Failed to create graphics object!") ;
-				#endif
+			window_target_ = &window ;
+			return true ;
+		}
+	#endif
 
-				return false ;
-			}
+		// mode rekam : primitive disimpan ke list, tidak ada canvas yang disentuh
+		bool Begin(DisplayList& list, uint64_t key = 0) noexcept {
+			if (is_drawing_) {
 
-			if (gfx_->GetLastStatus() != Gdiplus::Ok) {
 				#ifdef RENDERER_DEBUG
-					logger::error("Renderer::Begin - graphics status not OK : [", static_cast<int32_t>(gfx_ ? gfx_->GetLastStatus() : Gdiplus::GenericError), "] .") ;
+					logger::error("Renderer::Begin - Already in drawing state!") ;
 				#endif
 
-				gfx_.reset() ;
 				return false ;
 			}
 
-			canvas_target_ = window.back_buffer_.get() ;
-			window_target_ = &window ;
+			list.BeginRecord(key) ;
+			record_target_ = &list ;
 			is_drawing_ = true ;
-
-			gfx_->SetSmoothingMode(Gdiplus::SmoothingModeHighQuality) ;
-			gfx_->SetInterpolationMode(Gdiplus::InterpolationModeHighQualityBicubic) ;
-			gfx_->SetPixelOffsetMode(Gdiplus::PixelOffsetModeHighQuality) ;
-			gfx_->SetCompositingQuality(Gdiplus::CompositingQualityHighSpeed) ;
-			gfx_->SetCompositingMode(Gdiplus::CompositingModeSourceOver) ;
-
 			return true ;
 		}
 
 		void End() noexcept {
+			if (record_target_) {
+				record_target_->EndRecord() ;
+				record_target_ = nullptr ;
+				is_drawing_ = false ;
+				return ;
+			}
+
+			if (canvas_target_ && is_drawing_) {
+				ResolveRetain() ;
+			}
+
+		#ifdef ZKETCH_WIN32
 			if (window_target_) {
 				if (canvas_target_ && is_drawing_) {
+					// damage dibiarkan, dikonsumsi oleh Window::Present
 					if (window_target_->front_buffer_ && window_target_->back_buffer_) {
 						std::swap(window_target_->front_buffer_, window_target_->back_buffer_) ;
-						canvas_target_->MarkValidate() ;
+						window_target_->frame_damage_ = window_target_->front_buffer_->GetDamage() ;
+					}
+					// frame berisi perubahan : input window ini yang tertunda sudah berefek
+					if (!window_target_->frame_damage_.IsEmpty()) {
+						window_target_->latency_.NoteUpdate() ;
 					}
 				}
 			}
+
 			gfx_.reset() ;
+		#endif
+
+			raster_.Unbind() ;
 			canvas_target_ = nullptr ;
 			window_target_ = nullptr ;
+			retain_src_ = nullptr ;
+			retain_region_ = nullptr ;
 			is_drawing_ = false ;
+			software_ = false ;
 		}
 
 		void Clear(const Color& color) noexcept {
 			if (!IsValid()) {
 				return ;
 			}
+
+			if (record_target_) {
+				record_target_->PushClear(color) ;
+				return ;
+			}
+
+			// seluruh isi ditimpa, tidak perlu menyalin frame sebelumnya
+			retain_src_ = nullptr ;
+			retain_region_ = nullptr ;
 			
-			auto prevMode = gfx_->GetCompositingMode() ;
-			gfx_->SetCompositingMode(Gdiplus::CompositingModeSourceCopy) ;
-			gfx_->Clear(color) ;
-			gfx_->SetCompositingMode(prevMode) ;
+			if (software_) {
+				raster_.Clear(color) ;
+			} else {
+				#ifdef ZKETCH_WIN32
+					auto prevMode = gfx_->GetCompositingMode() ;
+					gfx_->SetCompositingMode(Gdiplus::CompositingModeSourceCopy) ;
+					gfx_->Clear(color) ;
+					gfx_->SetCompositingMode(prevMode) ;
+				#endif
+			}
 			
-			if (canvas_target_) {
-				canvas_target_->MarkInvalidate() ;
+			if (color.GetA() == 255) {
+				canvas_target_->MarkOpaque(Rect{0, 0, canvas_target_->GetWidth(), canvas_target_->GetHeight()}) ;
+			} else {
+				canvas_target_->ClearOpaque() ;
 			}
+			canvas_target_->MarkInvalidate() ;
 		}
 
 		void DrawRect(const RectF& rect, const Color& color, float thickness = 1.0f) noexcept {
@@ -228,18 +610,39 @@ namespace zketch {
 				return ;
 			}
 
-			if (thickness < 0.0f) {
+			if (!std::isfinite(thickness) || thickness < 0.0f) {
 
 				#ifdef RENDERER_DEBUG
-					logger::warning("Renderer::DrawRect - Thickness lower than 0.0") ;
+					logger::warning("Renderer::DrawRect - Thickness lower than 0.0 or not finite") ;
 				#endif
 
 				return ;
 			}
 
-			canvas_target_->MarkInvalidate() ;
-			Gdiplus::Pen p(color, thickness) ;
-			gfx_->DrawRectangle(&p, static_cast<Gdiplus::RectF>(rect)) ;
+			if (!IsFinite(rect)) {
+
+				#ifdef RENDERER_DEBUG
+					logger::warning("Renderer::DrawRect - Rect not finite") ;
+				#endif
+
+				return ;
+			}
+
+			if (record_target_) {
+				record_target_->PushShape(DrawOp::DrawRect, rect, color, thickness) ;
+				return ;
+			}
+
+			MarkDamage(rect, thickness) ;
+			if (software_) {
+				raster_.DrawRect(rect, color, thickness) ;
+				return ;
+			}
+
+			#ifdef ZKETCH_WIN32
+				Gdiplus::Pen* p = PaintCache::ForThread().GetPen(color, thickness) ;
+				gfx_->DrawRectangle(p, static_cast<Gdiplus::RectF>(rect)) ;
+			#endif
 		}
 
 		void FillRect(const Rect& rect, const Color& color) noexcept {
@@ -247,9 +650,25 @@ namespace zketch {
 				return ;
 			}
 
-			canvas_target_->MarkInvalidate() ;
-			Gdiplus::SolidBrush b(color) ;
-			gfx_->FillRectangle(&b, static_cast<Gdiplus::RectF>(rect)) ;
+			if (record_target_) {
+				record_target_->PushShape(DrawOp::FillRect, static_cast<RectF>(rect), color) ;
+				return ;
+			}
+
+			MarkDamage(static_cast<RectF>(rect)) ;
+			if (color.GetA() == 255) {
+				canvas_target_->MarkOpaque(rect) ;
+			}
+
+			if (software_) {
+				raster_.FillRect(static_cast<RectF>(rect), color) ;
+				return ;
+			}
+
+			#ifdef ZKETCH_WIN32
+				Gdiplus::SolidBrush* b = PaintCache::ForThread().GetBrush(color) ;
+				gfx_->FillRectangle(b, static_cast<Gdiplus::RectF>(rect)) ;
+			#endif
 		}
 
 		void DrawRectRounded(const RectF& rect, const Color& color, float radius, float thickness = 1.0f) noexcept {
@@ -257,180 +676,187 @@ namespace zketch {
 				return ;
 			}
 
-			if (thickness < 0.0f) {
+			if (!std::isfinite(thickness) || thickness < 0.0f) {
 
 				#ifdef RENDERER_DEBUG
-					logger::warning("Renderer::DrawRectRounded - Thickness lower than 0.0") ;
+					logger::warning("Renderer::DrawRectRounded - Thickness lower than 0.0 or not finite") ;
 				#endif
 
 				return ;
 			}
 
-			if (radius < 0.0f) {
+			if (!std::isfinite(radius) || radius < 0.0f) {
 
 				#ifdef RENDERER_DEBUG
-					logger::warning("Renderer::DrawRectRounded - Radius lower than 0.0") ;
+					logger::warning("Renderer::DrawRectRounded - Radius lower than 0.0 or not finite") ;
 				#endif
 				
 				return ;
 			}
 
-			canvas_target_->MarkInvalidate() ;
-			Gdiplus::GraphicsPath path ;
-			float diameter = radius * 2.0f ;
-			path.AddArc(rect.x, rect.y, diameter, diameter, 180, 90) ;
-			path.AddArc(rect.x + rect.w - diameter, rect.y, diameter, diameter, 270, 90) ;
-			path.AddArc(rect.x + rect.w - diameter, rect.y + rect.h - diameter, diameter, diameter, 0, 90) ;
-			path.AddArc(rect.x, rect.y + rect.h - diameter, diameter, diameter, 90, 90) ;
-			path.CloseFigure() ;
-			Gdiplus::Pen p(color, thickness) ;
-			gfx_->DrawPath(&p, &path) ;
-		}
+			if (!IsFinite(rect)) {
+
+				#ifdef RENDERER_DEBUG
+					logger::warning("Renderer::DrawRectRounded - Rect not finite") ;
+				#endif
 
-		void FillRectRounded(const RectF& rect, const Color& color, float radius) noexcept {
-			if (!IsValid()) {
 				return ;
 			}
 
-			if (radius < 0.0f) {
-
-				#ifdef RENDERER_DEBUG
-					logger::warning("Renderer::FillRectRounded - Radius lower than 0.0") ;
-				#endif
+			if (record_target_) {
+				record_target_->PushShape(DrawOp::DrawRectRounded, rect, color, thickness, radius) ;
+				return ;
+			}
 
+			MarkDamage(rect, thickness) ;
+			if (software_) {
+				raster_.DrawRectRounded(rect, color, radius, thickness) ;
 				return ;
 			}
 
-			canvas_target_->MarkInvalidate() ;
+			#ifdef ZKETCH_WIN32
+				const auto& outline = GeometryCache::ForThread().GetRoundedRect(rect.w, rect.h, radius, thickness) ;
+				if (outline.empty()) {
+					return ;
+				}
 
-			Gdiplus::GraphicsPath path ;
-			float diameter = radius * 2.0f ;
-			path.AddArc(rect.x, rect.y, diameter, diameter, 180, 90) ;
-			path.AddArc(rect.x + rect.w - diameter, rect.y, diameter, diameter, 270, 90) ;
-			path.AddArc(rect.x + rect.w - diameter, rect.y + rect.h - diameter, diameter, diameter, 0, 90) ;
-			path.AddArc(rect.x, rect.y + rect.h - diameter, diameter, diameter, 90, 90) ;
-			path.CloseFigure() ;
-			Gdiplus::SolidBrush b(color) ;
-			gfx_->FillPath(&b, &path) ;
+				const auto& points = TranslateOutline(outline, rect.x, rect.y) ;
+				Gdiplus::Pen* p = PaintCache::ForThread().GetPen(color, thickness) ;
+				gfx_->DrawPolygon(p, points.data(), static_cast<int>(points.size())) ;
+			#endif
 		}
 
-		void DrawEllipse(const RectF& rect, const Color& color, float thickness = 1.0f) noexcept {
+		void FillRectRounded(const RectF& rect, const Color& color, float radius) noexcept {
 			if (!IsValid()) {
 				return ;
 			}
 
-			if (thickness < 0.0f) {
+			if (!std::isfinite(radius) || radius < 0.0f) {
 
 				#ifdef RENDERER_DEBUG
-					logger::warning("Renderer::DrawEllipse - Thickness lower than 0.0") ;
+					logger::warning("Renderer::FillRectRounded - Radius lower than 0.0 or not finite") ;
 				#endif
 
 				return ;
 			}
 
-			canvas_target_->MarkInvalidate() ;
-			Gdiplus::Pen p(color, thickness) ;
-			gfx_->DrawEllipse(&p, static_cast<Gdiplus::RectF>(rect)) ;
-		}
+			if (!IsFinite(rect)) {
+
+				#ifdef RENDERER_DEBUG
+					logger::warning("Renderer::FillRectRounded - Rect not finite") ;
+				#endif
 
-		void FillEllipse(const RectF& rect, const zketch::Color& color) noexcept {
-			if (!IsValid()) {
 				return ;
 			}
 
-			canvas_target_->MarkInvalidate() ;
-			Gdiplus::SolidBrush b(color) ;
-			gfx_->FillEllipse(&b, rect.x, rect.y, rect.w, rect.h) ;
-		}
-
-		void DrawString(const std::wstring& text, const Point& pos, const Color& color, const Font& font) noexcept {
-			if (!IsValid()) {
+			if (record_target_) {
+				record_target_->PushShape(DrawOp::FillRectRounded, rect, color, 0.0f, radius) ;
 				return ;
 			}
 
-			if (text.empty()) {
-
-				#ifdef RENDERER_DEBUG
-					logger::warning("Renderer::DrawString - Text is empty") ;
-				#endif
-
+			MarkDamage(rect) ;
+			if (software_) {
+				raster_.FillRectRounded(rect, color, radius) ;
 				return ;
 			}
 
-			canvas_target_->MarkInvalidate() ;
-			Gdiplus::SolidBrush brush(color) ;
-			Gdiplus::Font used_font = font ;
-			gfx_->SetTextRenderingHint(Gdiplus::TextRenderingHintAntiAliasGridFit) ;
-			Gdiplus::RectF layout(static_cast<Gdiplus::REAL>(pos.x), static_cast<Gdiplus::REAL>(pos.y), static_cast<Gdiplus::REAL>(canvas_target_ ? canvas_target_->GetWidth() - pos.x : 0), static_cast<Gdiplus::REAL>(canvas_target_ ? canvas_target_->GetHeight() - pos.y : 0));
-			Gdiplus::StringFormat fmt ;
-			fmt.SetAlignment(Gdiplus::StringAlignmentNear) ;
-			fmt.SetLineAlignment(Gdiplus::StringAlignmentNear) ;
-			gfx_->DrawString(text.c_str(), -1, &used_font, layout, &fmt, &brush) ;
-		}
+			#ifdef ZKETCH_WIN32
+				const auto& outline = GeometryCache::ForThread().GetRoundedRect(rect.w, rect.h, radius) ;
+				if (outline.empty()) {
+					return ;
+				}
 
-		void DrawString(const std::string& text, const Point& pos, const Color& color, const Font& font) noexcept {
-			DrawString(StringToWideString(text), pos, color, font) ;
+				const auto& points = TranslateOutline(outline, rect.x, rect.y) ;
+				Gdiplus::SolidBrush* b = PaintCache::ForThread().GetBrush(color) ;
+				gfx_->FillPolygon(b, points.data(), static_cast<int>(points.size())) ;
+			#endif
 		}
 
-		void DrawPolygon(const Vertex& vertices, const Color& color, float thickness = 1.0f) noexcept {
+		void DrawEllipse(const RectF& rect, const Color& color, float thickness = 1.0f) noexcept {
 			if (!IsValid()) {
 				return ;
 			}
 
-			if (vertices.empty()) {
+			if (!std::isfinite(thickness) || thickness < 0.0f) {
 
 				#ifdef RENDERER_DEBUG
-					logger::warning("Renderer::DrawPolygon - Vertices is Empty") ;
+					logger::warning("Renderer::DrawEllipse - Thickness lower than 0.0 or not finite") ;
 				#endif
 
 				return ;
 			}
 
-			if (thickness < 0.0f) {
+			if (!IsFinite(rect)) {
 
 				#ifdef RENDERER_DEBUG
-					logger::warning("Renderer::DrawPolygon - Thickness lower than 0.0") ;
+					logger::warning("Renderer::DrawEllipse - Rect not finite") ;
 				#endif
 
 				return ;
 			}
 
-			canvas_target_->MarkInvalidate() ;
-			std::vector<Gdiplus::PointF> points ;
-			points.reserve(vertices.size()) ;
+			if (record_target_) {
+				record_target_->PushShape(DrawOp::DrawEllipse, rect, color, thickness) ;
+				return ;
+			}
 
-			for (const auto& v : vertices) {
-				points.emplace_back(v.x, v.y) ;
+			MarkDamage(rect, thickness) ;
+			if (software_) {
+				raster_.DrawEllipse(rect, color, thickness) ;
+				return ;
 			}
 
-			Gdiplus::Pen p(color, thickness) ;
-			gfx_->DrawPolygon(&p, points.data(), static_cast<int>(points.size())) ;
+			#ifdef ZKETCH_WIN32
+				Gdiplus::Pen* p = PaintCache::ForThread().GetPen(color, thickness) ;
+				gfx_->DrawEllipse(p, static_cast<Gdiplus::RectF>(rect)) ;
+			#endif
 		}
 
-		void FillPolygon(const Vertex& vertices, const Color& color) noexcept {
+		void FillEllipse(const RectF& rect, const zketch::Color& color) noexcept {
 			if (!IsValid()) {
 				return ;
 			}
 
-			if (vertices.empty()) {
+			if (!IsFinite(rect)) {
 
 				#ifdef RENDERER_DEBUG
-					logger::warning("Renderer::FillPolygon - Vertices is Empty") ;
+					logger::warning("Renderer::FillEllipse - Rect not finite") ;
 				#endif
 
 				return ;
 			}
 
-			canvas_target_->MarkInvalidate() ;
-			std::vector<Gdiplus::PointF> points ;
-			points.reserve(vertices.size()) ;
-			
-			for (const auto& v : vertices) {
-				points.emplace_back(v.x, v.y) ;
+			if (record_target_) {
+				record_target_->PushShape(DrawOp::FillEllipse, rect, color) ;
+				return ;
 			}
 
-			Gdiplus::SolidBrush b(color) ;
-			gfx_->FillPolygon(&b, points.data(), static_cast<int>(points.size())) ;
+			MarkDamage(rect) ;
+			if (software_) {
+				raster_.FillEllipse(rect, color) ;
+				return ;
+			}
+
+			#ifdef ZKETCH_WIN32
+				Gdiplus::SolidBrush* b = PaintCache::ForThread().GetBrush(color) ;
+				gfx_->FillEllipse(b, rect.x, rect.y, rect.w, rect.h) ;
+			#endif
+		}
+
+		void DrawString(const std::wstring& text, const Point& pos, const Color& color, const Font& font) noexcept {
+			DrawStringImpl(text.data(), text.size(), pos, color, font) ;
+		}
+
+		void DrawString(const std::string& text, const Point& pos, const Color& color, const Font& font) noexcept {
+			DrawString(StringToWideString(text), pos, color, font) ;
+		}
+
+		void DrawPolygon(const Vertex& vertices, const Color& color, float thickness = 1.0f) noexcept {
+			DrawPolygonImpl(vertices.data(), vertices.size(), color, thickness) ;
+		}
+
+		void FillPolygon(const Vertex& vertices, const Color& color) noexcept {
+			FillPolygonImpl(vertices.data(), vertices.size(), color) ;
 		}
 
 		void DrawLine(const Point& start, const Point& end, const Color& color, float thickness = 1.0f) noexcept {
@@ -438,18 +864,30 @@ namespace zketch {
 				return ;
 			}
 
-			if (thickness < 0.0f) {
+			if (!std::isfinite(thickness) || thickness < 0.0f) {
 
 				#ifdef RENDERER_DEBUG
-					logger::warning("Renderer::DrawLine - Thickness lower than 0.0") ;
+					logger::warning("Renderer::DrawLine - Thickness lower than 0.0 or not finite") ;
 				#endif
 
 				return ;
 			}
 
-			canvas_target_->MarkInvalidate() ;
-			Gdiplus::Pen p(color, thickness) ;
-			gfx_->DrawLine(&p, start.x, start.y, end.x, end.y) ;
+			if (record_target_) {
+				record_target_->PushLine(start, end, color, thickness) ;
+				return ;
+			}
+
+			MarkDamage(RectF{static_cast<float>(start.x), static_cast<float>(start.y), static_cast<float>(end.x - start.x), static_cast<float>(end.y - start.y)}, thickness * 0.5f) ;
+			if (software_) {
+				raster_.DrawLine(start, end, color, thickness) ;
+				return ;
+			}
+
+			#ifdef ZKETCH_WIN32
+				Gdiplus::Pen* p = PaintCache::ForThread().GetPen(color, thickness) ;
+				gfx_->DrawLine(p, start.x, start.y, end.x, end.y) ;
+			#endif
 		}
 
 		void DrawCircle(const Point& center, float radius, const Color& color, float thickness = 1.0f) noexcept {
@@ -457,7 +895,6 @@ namespace zketch {
 				return ;
 			}
 
-			canvas_target_->MarkInvalidate() ;
 			DrawEllipse(RectF{static_cast<float>(center.x - radius), static_cast<float>(center.y - radius), radius * 2.0f, radius * 2.0f}, color, thickness) ;
 		}
 
@@ -466,24 +903,50 @@ namespace zketch {
 				return ;
 			}
 
-			canvas_target_->MarkInvalidate() ;
 			FillEllipse(RectF{static_cast<float>(center.x - radius), static_cast<float>(center.y - radius), radius * 2.0f, radius * 2.0f}, color) ;
 		}
 
 		void DrawCanvas(const Canvas* src, const Point& pos) noexcept {
+			if (!src) {
+
+				#ifdef RENDERER_DEBUG
+					logger::warning("Renderer::DrawCanvas - Canvas source is null!") ;
+				#endif
+
+				return ;
+			}
+
 			if (!IsValid() || !src->IsValid()) { 
 				return ; 
 			}
 
-			if (!src) {
+			if (record_target_) {
+				record_target_->PushCanvas(src, pos) ;
+				return ;
+			}
 
-				#ifdef RENDERER_DEBUG
-					logger::warning("Renderer::DrawCanvas - Canvas source is null!") ;
+			ResolveRetain() ;
+
+			if (software_) {
+				if (const PixelBuffer* pixels = src->GetPixels()) {
+					raster_.Blit(*pixels, pos) ;
+				} else {
+				#ifdef ZKETCH_WIN32
+					// source GDI+ : baca sebagai PARGB lalu blend dengan rasterizer
+					Gdiplus::BitmapData data ;
+					Gdiplus::Rect area(0, 0, static_cast<INT>(src->GetWidth()), static_cast<INT>(src->GetHeight())) ;
+					if (src->GetBitmap()->LockBits(&area, Gdiplus::ImageLockModeRead, PixelFormat32bppPARGB, &data) == Gdiplus::Ok) {
+						raster_.Blit(static_cast<const uint32_t*>(data.Scan0), static_cast<uint32_t>(data.Stride) / sizeof(uint32_t), src->GetSize(), pos) ;
+						src->GetBitmap()->UnlockBits(&data) ;
+					}
 				#endif
+				}
 
+				canvas_target_->MarkInvalidate(Rect(pos, src->GetSize())) ;
 				return ;
 			}
 
+		#ifdef ZKETCH_WIN32
 			auto* bitmap = src->GetBitmap() ;
 			if (!bitmap) {
 
@@ -494,28 +957,122 @@ namespace zketch {
 				return ;
 			}
 
-			gfx_->DrawImage(bitmap, pos.x, pos.y ) ;
-			canvas_target_->MarkInvalidate() ;
+			// bitmap bisa lebih besar dari ukuran logis canvas (lihat Canvas::Resize)
+			gfx_->DrawImage(bitmap, pos.x, pos.y, 0, 0, static_cast<INT>(src->GetWidth()), static_cast<INT>(src->GetHeight()), Gdiplus::UnitPixel) ;
+			canvas_target_->MarkInvalidate(Rect(pos, src->GetSize())) ;
+		#endif
 		}
 
-		static RectF GetStringBound(const Font& font, const std::wstring_view& text, const PointF& origin = {}) noexcept {
-			Gdiplus::RectF res ;
-			Gdiplus::Font used_font = font ;
+		// memutar ulang list ke target saat ini (atau ke list lain bila sedang merekam)
+		void Replay(const DisplayList& list) noexcept {
+			if (!IsValid()) {
+				return ;
+			}
 
-			Gdiplus::Graphics g(GetDC(nullptr)) ;
+			list.ForEach([this](DrawOp op, const std::byte* data) {
+				using DL = DisplayList ;
+				switch (op) {
+					case DrawOp::Clear : {
+						auto cmd = DL::Read<DL::ClearCmd>(data) ;
+						Clear(Color(cmd.color_)) ;
+						break ;
+					}
 
-			if (g.GetLastStatus() != Gdiplus::Ok) {
-				#ifdef RENDERER_DEBUG
-					logger::error("Renderer::StringBound - Graphics status not OK : [", g.GetLastStatus(), "] .") ;
-				#endif
+					case DrawOp::DrawRect : {
+						auto cmd = DL::Read<DL::ShapeCmd>(data) ;
+						DrawRect(cmd.rect_, Color(cmd.color_), cmd.thickness_) ;
+						break ;
+					}
 
-				return false ;
+					case DrawOp::FillRect : {
+						auto cmd = DL::Read<DL::ShapeCmd>(data) ;
+						FillRect(static_cast<Rect>(cmd.rect_), Color(cmd.color_)) ;
+						break ;
+					}
+
+					case DrawOp::DrawRectRounded : {
+						auto cmd = DL::Read<DL::ShapeCmd>(data) ;
+						DrawRectRounded(cmd.rect_, Color(cmd.color_), cmd.radius_, cmd.thickness_) ;
+						break ;
+					}
+
+					case DrawOp::FillRectRounded : {
+						auto cmd = DL::Read<DL::ShapeCmd>(data) ;
+						FillRectRounded(cmd.rect_, Color(cmd.color_), cmd.radius_) ;
+						break ;
+					}
+
+					case DrawOp::DrawEllipse : {
+						auto cmd = DL::Read<DL::ShapeCmd>(data) ;
+						DrawEllipse(cmd.rect_, Color(cmd.color_), cmd.thickness_) ;
+						break ;
+					}
+
+					case DrawOp::FillEllipse : {
+						auto cmd = DL::Read<DL::ShapeCmd>(data) ;
+						FillEllipse(cmd.rect_, Color(cmd.color_)) ;
+						break ;
+					}
+
+					case DrawOp::DrawString : {
+						auto cmd = DL::Read<DL::StringCmd>(data) ;
+						Font font(std::wstring_view(cmd.font_name_, cmd.font_name_length_), cmd.font_size_, cmd.font_style_) ;
+						DrawStringImpl(DL::ReadExtra<DL::StringCmd, wchar_t>(data), cmd.length_, cmd.pos_, Color(cmd.color_), font) ;
+						break ;
+					}
+
+					case DrawOp::DrawPolygon : {
+						auto cmd = DL::Read<DL::PolygonCmd>(data) ;
+						DrawPolygonImpl(DL::ReadExtra<DL::PolygonCmd, PointF>(data), cmd.count_, Color(cmd.color_), cmd.thickness_) ;
+						break ;
+					}
+
+					case DrawOp::FillPolygon : {
+						auto cmd = DL::Read<DL::PolygonCmd>(data) ;
+						FillPolygonImpl(DL::ReadExtra<DL::PolygonCmd, PointF>(data), cmd.count_, Color(cmd.color_)) ;
+						break ;
+					}
+
+					case DrawOp::DrawLine : {
+						auto cmd = DL::Read<DL::LineCmd>(data) ;
+						DrawLine(cmd.start_, cmd.end_, Color(cmd.color_), cmd.thickness_) ;
+						break ;
+					}
+
+					case DrawOp::DrawCanvas : {
+						auto cmd = DL::Read<DL::CanvasCmd>(data) ;
+						DrawCanvas(cmd.src_, cmd.pos_) ;
+						break ;
+					}
+				}
+			}) ;
+		}
+
+		// replay paralel per tile untuk target software, selain itu (atau bila list berisi
+		// teks) jatuh ke replay serial biasa
+		void Replay(const DisplayList& list, TileRasterizer& tiles) noexcept {
+			if (!IsValid()) {
+				return ;
 			}
-			g.MeasureString(text.data(), -1, &used_font, origin, &res) ;
-			return res ;
+
+			if (!record_target_ && software_) {
+				ResolveRetain() ;
+				if (tiles.Render(*canvas_target_, list)) {
+					TrackOpaque(list) ;
+					return ;
+				}
+			}
+
+			Replay(list) ;
+		}
+
+		// diukur dari tabel advance FontMetricsCache, tanpa DC / Graphics per panggilan
+		static RectF GetStringBound(const Font& font, const std::wstring_view& text, const PointF& origin = {}) noexcept {
+			return FontMetricsCache::ForThread().Get(font).Bound(text, origin) ;
 		}
 
 		bool IsDrawing() const noexcept { return is_drawing_ ; }
+		bool IsRecording() const noexcept { return record_target_ != nullptr ; }
 		Canvas* GetTarget() const noexcept { return canvas_target_ ; }
 	} ;
 }
\ No newline at end of file
@@ -152,12 +152,12 @@ namespace zketch {
             }
             
             canvas_ = std::make_unique<Canvas>() ;
-            canvas_->Create(bound_.GetSize()) ;
-			thumb_canvas_->Create(thumb) ;
+            CreateSurface(*canvas_, bound_.GetSize()) ;
+			CreateSurface(*thumb_canvas_, thumb) ;
 
             RenderThumb() ;
             RenderTrack() ;
-            update_ = true ;
+            MarkDirty() ;
         }
 
         bool OnHover(const PointF& mouse_pos) noexcept {
@@ -165,7 +165,7 @@ namespace zketch {
             if (state != is_hovered_) {
                 is_hovered_ = state ;
                 thumb_needs_update_ = true ;
-                update_ = true ;
+                MarkDirty() ;
                 EventSystem::PushEvent(Event::CreateSliderEvent(SliderState::Hover, value_, this)) ;
             }
             return state ;
@@ -178,7 +178,7 @@ namespace zketch {
                     mouse_pos.y - thumb_bound_.y : 
                     mouse_pos.x - thumb_bound_.x ;
                 thumb_needs_update_ = true ;
-                update_ = true ;
+                MarkDirty() ;
                 EventSystem::PushEvent(Event::CreateSliderEvent(SliderState::Start, value_, this)) ;
                 return true ;
             }
@@ -201,7 +201,7 @@ namespace zketch {
                 is_dragging_ = true ;
                 offset_ = orientation_ == Vertical ? thumb_bound_.h / 2.0f : thumb_bound_.w / 2.0f ;
                 thumb_needs_update_ = true ;
-                update_ = true ;
+                MarkDirty() ;
                 EventSystem::PushEvent(Event::CreateSliderEvent(SliderState::Start, value_, this)) ;
                 EventSystem::PushEvent(Event::CreateSliderEvent(SliderState::Changed, value_, this)) ;
                 return true ;
@@ -214,7 +214,7 @@ namespace zketch {
             if (is_dragging_) {
                 is_dragging_ = false ;
                 thumb_needs_update_ = true ;
-                update_ = true ;
+                MarkDirty() ;
                 EventSystem::PushEvent(Event::CreateSliderEvent(SliderState::End, value_, this)) ;
                 return true ;
             }
@@ -241,14 +241,14 @@ namespace zketch {
                 ) ;
             }
             UpdateValueFromThumb() ;
-            update_ = true ;
+            MarkDirty() ;
             EventSystem::PushEvent(Event::CreateSliderEvent(SliderState::Changed, value_, this)) ;
             return true ;
         }
 
         void SetDrawingLogic(std::function<void(Canvas*, const Slider&)> drawing_logic) noexcept {
             drawing_logic_ = std::move(drawing_logic) ;
-            update_ = true ;
+            MarkDirty() ;
             thumb_needs_update_ = true ;
         }
         
@@ -257,7 +257,7 @@ namespace zketch {
             value_ = std::clamp(value, min_value_, max_value_) ;
             if (old_value != value_) {
                 UpdateThumbFromValue() ;
-                update_ = true ;
+                MarkDirty() ;
             }
         }
         
@@ -266,7 +266,7 @@ namespace zketch {
             max_value_ = max_val ;
             value_ = std::clamp(value_, min_value_, max_value_) ;
             UpdateThumbFromValue() ;
-            update_ = true ;
+            MarkDirty() ;
         }
 
 		bool IsHovered() const noexcept { return is_hovered_ ; }
@@ -0,0 +1,248 @@
+#pragma once
+#include "unit.hpp"
+
+namespace zketch {
+
+	using SpatialId = uint32_t ;
+	inline constexpr SpatialId InvalidSpatialId = 0xFFFFFFFF ;
+
+	// grid seragam untuk hit test. tiap bound didaftarkan ke semua cell yang disentuhnya,
+	// query titik hanya memeriksa isi satu cell. bound yang menyentuh lebih dari
+	// MaxCellsPerEntry cell disimpan di daftar terpisah yang diperiksa linear.
+	// urutan (z) : entry yang didaftarkan / di-Raise belakangan berada di atas.
+	class SpatialGrid {
+	public :
+		static constexpr float DefaultCellSize = 64.0f ;
+		static constexpr uint32_t MaxCellsPerEntry = 64 ;
+
+	private :
+		struct Entry {
+			RectF bound_ ;
+			void* user_ ;
+			uint64_t order_ ;
+			int32_t cx0_, cy0_, cx1_, cy1_ ; // range cell inklusif
+			bool large_ ;
+			bool live_ ;
+		} ;
+
+		std::vector<Entry> entries_ ;
+		std::vector<SpatialId> free_ ;
+		std::unordered_map<uint64_t, std::vector<SpatialId>> cells_ ;
+		std::vector<SpatialId> large_ ;
+		float cell_size_ ;
+		float inv_cell_ ;
+		uint64_t next_order_ = 0 ;
+		uint32_t count_ = 0 ;
+
+		static uint64_t Key(int32_t cx, int32_t cy) noexcept {
+			return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy) ;
+		}
+
+		int32_t CellOf(float v) const noexcept {
+			return static_cast<int32_t>(std::floor(std::clamp(v * inv_cell_, -1.0e9f, 1.0e9f))) ;
+		}
+
+		// tepi inklusif, sama dengan RectF::Contain
+		static bool Hit(const RectF& r, const PointF& p) noexcept {
+			return p.x >= r.x && p.y >= r.y && p.x <= r.x + r.w && p.y <= r.y + r.h ;
+		}
+
+		static void EraseFrom(std::vector<SpatialId>& list, SpatialId id) noexcept {
+			for (size_t i = 0; i < list.size(); ++i) {
+				if (list[i] == id) {
+					list[i] = list.back() ;
+					list.pop_back() ;
+					return ;
+				}
+			}
+		}
+
+		void Link(SpatialId id) {
+			Entry& e = entries_[id] ;
+			e.cx0_ = CellOf(e.bound_.x) ;
+			e.cy0_ = CellOf(e.bound_.y) ;
+			e.cx1_ = CellOf(e.bound_.x + e.bound_.w) ;
+			e.cy1_ = CellOf(e.bound_.y + e.bound_.h) ;
+
+			uint64_t cells = static_cast<uint64_t>(e.cx1_ - e.cx0_ + 1) * static_cast<uint64_t>(e.cy1_ - e.cy0_ + 1) ;
+			e.large_ = cells > MaxCellsPerEntry ;
+			if (e.large_) {
+				large_.push_back(id) ;
+				return ;
+			}
+
+			for (int32_t cy = e.cy0_; cy <= e.cy1_; ++cy) {
+				for (int32_t cx = e.cx0_; cx <= e.cx1_; ++cx) {
+					cells_[Key(cx, cy)].push_back(id) ;
+				}
+			}
+		}
+
+		void Unlink(SpatialId id) noexcept {
+			const Entry& e = entries_[id] ;
+			if (e.large_) {
+				EraseFrom(large_, id) ;
+				return ;
+			}
+
+			for (int32_t cy = e.cy0_; cy <= e.cy1_; ++cy) {
+				for (int32_t cx = e.cx0_; cx <= e.cx1_; ++cx) {
+					auto it = cells_.find(Key(cx, cy)) ;
+					if (it == cells_.end()) {
+						continue ;
+					}
+
+					EraseFrom(it->second, id) ;
+					if (it->second.empty()) {
+						cells_.erase(it) ;
+					}
+				}
+			}
+		}
+
+		void Consider(SpatialId id, const PointF& p, SpatialId& best, uint64_t& best_order) const noexcept {
+			const Entry& e = entries_[id] ;
+			if ((best == InvalidSpatialId || e.order_ > best_order) && Hit(e.bound_, p)) {
+				best = id ;
+				best_order = e.order_ ;
+			}
+		}
+
+	public :
+		explicit SpatialGrid(float cell_size = DefaultCellSize) noexcept :
+		cell_size_(std::max(cell_size, 1.0f)),
+		inv_cell_(1.0f / std::max(cell_size, 1.0f)) {}
+
+		SpatialId Insert(const RectF& bound, void* user = nullptr) noexcept {
+			SpatialId id ;
+			try {
+				if (!free_.empty()) {
+					id = free_.back() ;
+					free_.pop_back() ;
+				} else {
+					id = static_cast<SpatialId>(entries_.size()) ;
+					entries_.emplace_back() ;
+				}
+
+				entries_[id] = Entry{bound, user, next_order_++, 0, 0, 0, 0, false, true} ;
+				Link(id) ;
+			} catch (...) {
+
+				#ifdef WIDGET_DEBUG
+					logger::error("SpatialGrid::Insert - Out of memory.") ;
+				#endif
+
+				return InvalidSpatialId ;
+			}
+
+			++count_ ;
+			return id ;
+		}
+
+		// hanya cell yang berubah yang disentuh
+		void Update(SpatialId id, const RectF& bound) noexcept {
+			if (!IsValid(id)) {
+				return ;
+			}
+
+			Entry& e = entries_[id] ;
+			e.bound_ = bound ;
+			if (!e.large_ &&
+				CellOf(bound.x) == e.cx0_ && CellOf(bound.y) == e.cy0_ &&
+				CellOf(bound.x + bound.w) == e.cx1_ && CellOf(bound.y + bound.h) == e.cy1_) {
+				return ;
+			}
+
+			Unlink(id) ;
+			try {
+				Link(id) ;
+			} catch (...) {
+				Remove(id) ;
+			}
+		}
+
+		void Remove(SpatialId id) noexcept {
+			if (!IsValid(id)) {
+				return ;
+			}
+
+			Unlink(id) ;
+			entries_[id].live_ = false ;
+			entries_[id].user_ = nullptr ;
+			--count_ ;
+			try {
+				free_.push_back(id) ;
+			} catch (...) {}
+		}
+
+		// pindahkan ke paling atas
+		void Raise(SpatialId id) noexcept {
+			if (IsValid(id)) {
+				entries_[id].order_ = next_order_++ ;
+			}
+		}
+
+		// entry paling atas yang berisi p, InvalidSpatialId bila tidak ada
+		SpatialId Query(const PointF& p) const noexcept {
+			SpatialId best = InvalidSpatialId ;
+			uint64_t best_order = 0 ;
+
+			auto it = cells_.find(Key(CellOf(p.x), CellOf(p.y))) ;
+			if (it != cells_.end()) {
+				for (SpatialId id : it->second) {
+					Consider(id, p, best, best_order) ;
+				}
+			}
+
+			for (SpatialId id : large_) {
+				Consider(id, p, best, best_order) ;
+			}
+			return best ;
+		}
+
+		// semua entry yang berisi p, urutan atas ke bawah
+		void QueryAll(const PointF& p, std::vector<SpatialId>& out) const {
+			out.clear() ;
+			auto it = cells_.find(Key(CellOf(p.x), CellOf(p.y))) ;
+			if (it != cells_.end()) {
+				for (SpatialId id : it->second) {
+					if (Hit(entries_[id].bound_, p)) {
+						out.push_back(id) ;
+					}
+				}
+			}
+
+			for (SpatialId id : large_) {
+				if (Hit(entries_[id].bound_, p)) {
+					out.push_back(id) ;
+				}
+			}
+
+			std::sort(out.begin(), out.end(), [this](SpatialId a, SpatialId b) {
+				return entries_[a].order_ > entries_[b].order_ ;
+			}) ;
+		}
+
+		void* QueryUser(const PointF& p) const noexcept {
+			SpatialId id = Query(p) ;
+			return id == InvalidSpatialId ? nullptr : entries_[id].user_ ;
+		}
+
+		void Clear() noexcept {
+			entries_.clear() ;
+			free_.clear() ;
+			cells_.clear() ;
+			large_.clear() ;
+			count_ = 0 ;
+		}
+
+		bool IsValid(SpatialId id) const noexcept { return id < entries_.size() && entries_[id].live_ ; }
+
+		const RectF& GetBound(SpatialId id) const noexcept { return entries_[id].bound_ ; }
+		void* GetUser(SpatialId id) const noexcept { return entries_[id].user_ ; }
+		uint32_t GetCount() const noexcept { return count_ ; }
+		size_t GetCellCount() const noexcept { return cells_.size() ; }
+		size_t GetLargeCount() const noexcept { return large_.size() ; }
+		float GetCellSize() const noexcept { return cell_size_ ; }
+	} ;
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+#pragma once
+#include "logger.hpp"
+
+namespace zketch {
+
+	// pool memori pixel untuk PixelBuffer. ukuran dibulatkan ke size class (kelipatan
+	// seperempat pangkat dua, minimal MinBytes) dan block yang dilepas disimpan per
+	// class untuk dipakai ulang. kapasitas hanya bertambah, memori baru kembali ke heap
+	// lewat Trim().
+	class SurfacePool {
+	public :
+		static constexpr size_t Alignment = 64 ;
+		static constexpr uint32_t MinShift = 12 ;
+		static constexpr size_t MinBytes = size_t(1) << MinShift ;
+
+		struct Stats {
+			uint64_t live_bytes_ = 0 ;
+			uint64_t peak_live_bytes_ = 0 ;
+			uint64_t cached_bytes_ = 0 ;
+			uint64_t heap_allocations_ = 0 ;
+			uint64_t reuses_ = 0 ;
+		} ;
+
+	private :
+		mutable std::mutex mutex_ ;
+		std::vector<std::vector<void*>> free_ ; // index = size class
+		Stats stats_ {} ;
+
+		static void Free(void* p) noexcept {
+			::operator delete[](p, std::align_val_t{Alignment}) ;
+		}
+
+	public :
+		SurfacePool(const SurfacePool&) = delete ;
+		SurfacePool& operator=(const SurfacePool&) = delete ;
+		SurfacePool() = default ;
+
+		~SurfacePool() noexcept {
+			Trim() ;
+		}
+
+		// sengaja tidak pernah dihancurkan, canvas static boleh dilepas setelah exit
+		static SurfacePool& Global() noexcept {
+			static SurfacePool* pool = new SurfacePool ;
+			return *pool ;
+		}
+
+		// 1 .. 4 per pangkat dua : 1.25, 1.5, 1.75, 2 kali 2^n
+		static size_t ClassOf(size_t bytes, size_t* class_bytes = nullptr) noexcept {
+			if (bytes <= MinBytes) {
+				if (class_bytes) {
+					*class_bytes = MinBytes ;
+				}
+				return 0 ;
+			}
+
+			uint32_t n = static_cast<uint32_t>(std::bit_width(bytes - 1)) - 1 ;
+			size_t step = size_t(1) << (n - 2) ;
+			size_t quarters = (bytes + step - 1) / step ; // 5 .. 8
+			if (class_bytes) {
+				*class_bytes = quarters * step ;
+			}
+			return 1 + static_cast<size_t>(n - MinShift) * 4 + (quarters - 5) ;
+		}
+
+		// bytes ditulis ulang dengan kapasitas block, pakai nilai itu saat Release
+		void* Acquire(size_t& bytes) noexcept {
+			size_t capacity ;
+			size_t index = ClassOf(bytes, &capacity) ;
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_) ;
+				if (index < free_.size() && !free_[index].empty()) {
+					void* p = free_[index].back() ;
+					free_[index].pop_back() ;
+					stats_.cached_bytes_ -= capacity ;
+					stats_.live_bytes_ += capacity ;
+					stats_.peak_live_bytes_ = std::max(stats_.peak_live_bytes_, stats_.live_bytes_) ;
+					++stats_.reuses_ ;
+					bytes = capacity ;
+					return p ;
+				}
+			}
+
+			void* p = ::operator new[](capacity, std::align_val_t{Alignment}, std::nothrow) ;
+			if (!p) {
+
+				#ifdef CANVAS_DEBUG
+					logger::error("SurfacePool::Acquire - Failed to allocate ", capacity, " bytes.") ;
+				#endif
+
+				return nullptr ;
+			}
+
+			std::lock_guard<std::mutex> lock(mutex_) ;
+			stats_.live_bytes_ += capacity ;
+			stats_.peak_live_bytes_ = std::max(stats_.peak_live_bytes_, stats_.live_bytes_) ;
+			++stats_.heap_allocations_ ;
+			bytes = capacity ;
+			return p ;
+		}
+
+		void Release(void* p, size_t bytes) noexcept {
+			if (!p) {
+				return ;
+			}
+
+			size_t index = ClassOf(bytes) ;
+
+			std::lock_guard<std::mutex> lock(mutex_) ;
+			stats_.live_bytes_ -= bytes ;
+			try {
+				if (free_.size() <= index) {
+					free_.resize(index + 1) ;
+				}
+				free_[index].push_back(p) ;
+				stats_.cached_bytes_ += bytes ;
+			} catch (...) {
+				Free(p) ;
+			}
+		}
+
+		// kembalikan semua block yang sedang tidak dipakai ke heap
+		void Trim() noexcept {
+			std::lock_guard<std::mutex> lock(mutex_) ;
+			for (auto& list : free_) {
+				for (void* p : list) {
+					Free(p) ;
+				}
+				list.clear() ;
+			}
+			stats_.cached_bytes_ = 0 ;
+		}
+
+		void ResetPeak() noexcept {
+			std::lock_guard<std::mutex> lock(mutex_) ;
+			stats_.peak_live_bytes_ = stats_.live_bytes_ ;
+		}
+
+		Stats GetStats() const noexcept {
+			std::lock_guard<std::mutex> lock(mutex_) ;
+			return stats_ ;
+		}
+
+		uint64_t GetLiveBytes() const noexcept { return GetStats().live_bytes_ ; }
+		uint64_t GetPeakBytes() const noexcept { return GetStats().peak_live_bytes_ ; }
+		uint64_t GetCachedBytes() const noexcept { return GetStats().cached_bytes_ ; }
+	} ;
+}
\ No newline at end of file
@@ -9,6 +9,7 @@ namespace zketch {
         std::wstring text_ ;
         Font font_ ;
         std::function<void(Canvas*, const TextBox&)> drawing_logic_ ;
+		mutable ChromeCache<1> chrome_ ;
 
 		void UpdateImpl() noexcept {
             if (!drawing_logic_) {
@@ -26,7 +27,7 @@ namespace zketch {
         TextBox(const RectF& bound, const std::wstring& text, const Font& font) noexcept : text_(text), font_(font) {
             bound_ = bound ;
             canvas_ = std::make_unique<Canvas>() ;
-            canvas_->Create(bound_.GetSize()) ;
+            CreateSurface(*canvas_, bound_.GetSize()) ;
             
             SetDrawingLogic([](Canvas* canvas, const TextBox& textbox) {
                 Renderer render ;
@@ -35,19 +36,7 @@ namespace zketch {
                 }
 
 				render.Clear(Transparent) ;
-                
-                render.FillRectRounded(
-                    textbox.GetRelativeBound(), 
-                    Red,
-                    3.0f
-                ) ;
-                
-                render.DrawRectRounded(
-                    textbox.GetRelativeBound(),
-                    White,
-                    3.0f,
-                    1.0f
-                ) ;
+                render.DrawCanvas(textbox.GetChrome(), {0, 0}) ;
                 
                 render.DrawString(
                     textbox.GetText(), 
@@ -63,20 +52,31 @@ namespace zketch {
         void SetText(const std::wstring_view& text) noexcept {
             if (text_ != text) {
                 text_ = text ;
-                update_ = true ;
+                MarkDirty() ;
             }
         }
 
         void SetFont(const Font& font) noexcept {
             font_ = font ;
-            update_ = true ;
+            MarkDirty() ;
         }
         
         void SetDrawingLogic(std::function<void(Canvas*, const TextBox&)> drawing_logic) noexcept {
             drawing_logic_ = std::move(drawing_logic) ;
-            update_ = true ;
+            MarkDirty() ;
         }
 
+		// frame default, direkam dan dirasterisasi sekali per ukuran
+		const Canvas* GetChrome() const noexcept {
+			uint64_t key = DisplayList::MakeKey(bound_.w, bound_.h) ;
+			return chrome_.Get(0, key, GetRelativeBound().GetSize(), [this](Renderer& recorder) {
+				recorder.FillRectRounded(GetRelativeBound(), Red, 3.0f) ;
+				recorder.DrawRectRounded(GetRelativeBound(), White, 3.0f, 1.0f) ;
+			}) ;
+		}
+
+		const ChromeCache<1>& GetChromeCache() const noexcept { return chrome_ ; }
+
         RectF GetRelativeBound() const noexcept { return {0, 0, bound_.w, bound_.h} ; }
         const std::wstring& GetText() const noexcept { return text_ ; }
         const Font& GetFont() const noexcept { return font_ ; }
@@ -0,0 +1,127 @@
+#pragma once
+#include "logger.hpp"
+
+namespace zketch {
+
+	// pool sederhana untuk ParallelFor. thread pemanggil ikut bekerja sebagai worker 0,
+	// jadi ThreadPool(1) tidak membuat thread sama sekali.
+	class ThreadPool {
+	private :
+		using Invoke = void(*)(const void* fn, uint32_t task, uint32_t worker) ;
+
+		std::vector<std::thread> workers_ ;
+		std::mutex mutex_ ;
+		std::condition_variable wake_ ;
+		std::condition_variable done_ ;
+
+		const void* fn_ = nullptr ;
+		Invoke invoke_ = nullptr ;
+		uint32_t task_count_ = 0 ;
+		std::atomic<uint32_t> next_task_ {0} ;
+		uint32_t busy_ = 0 ;
+		uint64_t generation_ = 0 ;
+		bool stop_ = false ;
+
+		void RunTasks(uint32_t worker) noexcept {
+			for (;;) {
+				uint32_t task = next_task_.fetch_add(1, std::memory_order_relaxed) ;
+				if (task >= task_count_) {
+					return ;
+				}
+				invoke_(fn_, task, worker) ;
+			}
+		}
+
+		void WorkerLoop(uint32_t worker) noexcept {
+			uint64_t seen = 0 ;
+			for (;;) {
+				{
+					std::unique_lock<std::mutex> lock(mutex_) ;
+					wake_.wait(lock, [&] { return stop_ || generation_ != seen ; }) ;
+					if (stop_) {
+						return ;
+					}
+					seen = generation_ ;
+				}
+
+				RunTasks(worker) ;
+
+				std::lock_guard<std::mutex> lock(mutex_) ;
+				if (--busy_ == 0) {
+					done_.notify_one() ;
+				}
+			}
+		}
+
+	public :
+		ThreadPool(const ThreadPool&) = delete ;
+		ThreadPool& operator=(const ThreadPool&) = delete ;
+
+		// 0 = std::thread::hardware_concurrency()
+		explicit ThreadPool(uint32_t threads = 0) noexcept {
+			if (threads == 0) {
+				threads = std::max(std::thread::hardware_concurrency(), 1u) ;
+			}
+
+			try {
+				workers_.reserve(threads - 1) ;
+				for (uint32_t i = 1; i < threads; ++i) {
+					workers_.emplace_back([this, i] { WorkerLoop(i) ; }) ;
+				}
+			} catch (...) {
+
+				#ifdef THREADPOOL_DEBUG
+					logger::warning("ThreadPool::ThreadPool - Failed to spawn worker, running with ", workers_.size() + 1, " thread(s).") ;
+				#endif
+
+			}
+		}
+
+		~ThreadPool() noexcept {
+			{
+				std::lock_guard<std::mutex> lock(mutex_) ;
+				stop_ = true ;
+			}
+			wake_.notify_all() ;
+			for (auto& w : workers_) {
+				w.join() ;
+			}
+		}
+
+		// fn(task, worker) untuk task 0 .. count - 1, kembali setelah semua selesai.
+		// worker < GetThreadCount(), aman dipakai sebagai index data per worker.
+		template <typename Fn>
+		void ParallelFor(uint32_t count, const Fn& fn) noexcept {
+			if (count == 0) {
+				return ;
+			}
+
+			if (workers_.empty() || count == 1) {
+				for (uint32_t i = 0; i < count; ++i) {
+					fn(i, 0u) ;
+				}
+				return ;
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(mutex_) ;
+				fn_ = &fn ;
+				invoke_ = [](const void* f, uint32_t task, uint32_t worker) {
+					(*static_cast<const Fn*>(f))(task, worker) ;
+				} ;
+				task_count_ = count ;
+				next_task_.store(0, std::memory_order_relaxed) ;
+				busy_ = static_cast<uint32_t>(workers_.size()) ;
+				++generation_ ;
+			}
+			wake_.notify_all() ;
+
+			RunTasks(0) ;
+
+			std::unique_lock<std::mutex> lock(mutex_) ;
+			done_.wait(lock, [&] { return busy_ == 0 ; }) ;
+		}
+
+		uint32_t GetThreadCount() const noexcept { return static_cast<uint32_t>(workers_.size()) + 1 ; }
+	} ;
+}
\ No newline at end of file
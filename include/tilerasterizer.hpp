@@ -0,0 +1,274 @@
+#pragma once
+#include "canvas.hpp"
+#include "displaylist.hpp"
+#include "threadpool.hpp"
+
+namespace zketch {
+
+	// memutar DisplayList ke canvas software secara paralel. command dibagi ke tile
+	// berukuran tetap sesuai bounds-nya, lalu tiap tile dirasterisasi dengan clip tile
+	// oleh satu worker. urutan command dalam tile tetap, jadi hasilnya identik dengan
+	// replay serial.
+	class TileRasterizer {
+	private :
+		struct Command {
+			DrawOp op_ ;
+			const std::byte* data_ ;
+			Rect bounds_ ;
+		} ;
+
+		ThreadPool pool_ ;
+		std::vector<Rasterizer> rasters_ ;
+		std::vector<Command> commands_ ;
+		std::vector<std::vector<uint32_t>> bins_ ;
+		std::vector<uint32_t> active_tiles_ ;
+		uint32_t tile_size_ = DefaultTileSize ;
+		uint64_t binned_ = 0 ;
+
+		// dibulatkan keluar + 1 pixel, sama seperti damage di Renderer
+		static Rect Bounds(const RectF& r, float grow = 0.0f) noexcept {
+			constexpr float limit = 1.0e9f ;
+			float pad = grow + 1.0f ;
+			float l = std::clamp(std::min(r.x, r.x + r.w) - pad, -limit, limit) ;
+			float t = std::clamp(std::min(r.y, r.y + r.h) - pad, -limit, limit) ;
+			float rr = std::clamp(std::max(r.x, r.x + r.w) + pad, -limit, limit) ;
+			float b = std::clamp(std::max(r.y, r.y + r.h) + pad, -limit, limit) ;
+			int32_t x0 = static_cast<int32_t>(std::floor(l)) ;
+			int32_t y0 = static_cast<int32_t>(std::floor(t)) ;
+			return Rect(x0, y0, static_cast<uint32_t>(static_cast<int32_t>(std::ceil(rr)) - x0), static_cast<uint32_t>(static_cast<int32_t>(std::ceil(b)) - y0)) ;
+		}
+
+		static Rect PolygonBounds(const PointF* points, uint32_t count, float grow) noexcept {
+			if (count == 0) {
+				return {} ;
+			}
+
+			float l = points[0].x, t = points[0].y, r = l, b = t ;
+			for (uint32_t i = 1; i < count; ++i) {
+				l = std::min(l, points[i].x) ;
+				t = std::min(t, points[i].y) ;
+				r = std::max(r, points[i].x) ;
+				b = std::max(b, points[i].y) ;
+			}
+			return Bounds({l, t, r - l, b - t}, grow) ;
+		}
+
+		// false bila command tidak bisa digambar per tile (teks, source non-software)
+		static bool CommandBounds(DrawOp op, const std::byte* data, const Size& size, Rect& out) noexcept {
+			using DL = DisplayList ;
+			switch (op) {
+				case DrawOp::Clear :
+					out = Rect{0, 0, size.x, size.y} ;
+					return true ;
+
+				case DrawOp::FillRect :
+				case DrawOp::FillRectRounded :
+				case DrawOp::FillEllipse :
+					out = Bounds(DL::Read<DL::ShapeCmd>(data).rect_) ;
+					return true ;
+
+				case DrawOp::DrawRect :
+				case DrawOp::DrawRectRounded :
+				case DrawOp::DrawEllipse : {
+					auto cmd = DL::Read<DL::ShapeCmd>(data) ;
+					out = Bounds(cmd.rect_, cmd.thickness_ * 0.5f) ;
+					return true ;
+				}
+
+				case DrawOp::DrawPolygon :
+				case DrawOp::FillPolygon : {
+					auto cmd = DL::Read<DL::PolygonCmd>(data) ;
+					out = PolygonBounds(DL::ReadExtra<DL::PolygonCmd, PointF>(data), cmd.count_, cmd.thickness_ * 0.5f) ;
+					return true ;
+				}
+
+				case DrawOp::DrawLine : {
+					auto cmd = DL::Read<DL::LineCmd>(data) ;
+					RectF r {static_cast<float>(cmd.start_.x), static_cast<float>(cmd.start_.y), static_cast<float>(cmd.end_.x - cmd.start_.x), static_cast<float>(cmd.end_.y - cmd.start_.y)} ;
+					out = Bounds(r, cmd.thickness_ * 0.5f) ;
+					return true ;
+				}
+
+				case DrawOp::DrawCanvas : {
+					auto cmd = DL::Read<DL::CanvasCmd>(data) ;
+					if (!cmd.src_ || !cmd.src_->GetPixels()) {
+						return false ;
+					}
+					out = Rect(cmd.pos_, cmd.src_->GetSize()) ;
+					return true ;
+				}
+
+				case DrawOp::DrawString :
+					return false ;
+			}
+
+			return false ;
+		}
+
+		static void Execute(Rasterizer& r, DrawOp op, const std::byte* data) noexcept {
+			using DL = DisplayList ;
+			switch (op) {
+				case DrawOp::Clear :
+					r.Clear(Color(DL::Read<DL::ClearCmd>(data).color_)) ;
+					break ;
+
+				case DrawOp::DrawRect : {
+					auto cmd = DL::Read<DL::ShapeCmd>(data) ;
+					r.DrawRect(cmd.rect_, Color(cmd.color_), cmd.thickness_) ;
+					break ;
+				}
+
+				case DrawOp::FillRect : {
+					auto cmd = DL::Read<DL::ShapeCmd>(data) ;
+					r.FillRect(cmd.rect_, Color(cmd.color_)) ;
+					break ;
+				}
+
+				case DrawOp::DrawRectRounded : {
+					auto cmd = DL::Read<DL::ShapeCmd>(data) ;
+					r.DrawRectRounded(cmd.rect_, Color(cmd.color_), cmd.radius_, cmd.thickness_) ;
+					break ;
+				}
+
+				case DrawOp::FillRectRounded : {
+					auto cmd = DL::Read<DL::ShapeCmd>(data) ;
+					r.FillRectRounded(cmd.rect_, Color(cmd.color_), cmd.radius_) ;
+					break ;
+				}
+
+				case DrawOp::DrawEllipse : {
+					auto cmd = DL::Read<DL::ShapeCmd>(data) ;
+					r.DrawEllipse(cmd.rect_, Color(cmd.color_), cmd.thickness_) ;
+					break ;
+				}
+
+				case DrawOp::FillEllipse : {
+					auto cmd = DL::Read<DL::ShapeCmd>(data) ;
+					r.FillEllipse(cmd.rect_, Color(cmd.color_)) ;
+					break ;
+				}
+
+				case DrawOp::DrawPolygon : {
+					auto cmd = DL::Read<DL::PolygonCmd>(data) ;
+					r.DrawPolygon(DL::ReadExtra<DL::PolygonCmd, PointF>(data), cmd.count_, Color(cmd.color_), cmd.thickness_) ;
+					break ;
+				}
+
+				case DrawOp::FillPolygon : {
+					auto cmd = DL::Read<DL::PolygonCmd>(data) ;
+					r.FillPolygon(DL::ReadExtra<DL::PolygonCmd, PointF>(data), cmd.count_, Color(cmd.color_)) ;
+					break ;
+				}
+
+				case DrawOp::DrawLine : {
+					auto cmd = DL::Read<DL::LineCmd>(data) ;
+					r.DrawLine(cmd.start_, cmd.end_, Color(cmd.color_), cmd.thickness_) ;
+					break ;
+				}
+
+				case DrawOp::DrawCanvas : {
+					auto cmd = DL::Read<DL::CanvasCmd>(data) ;
+					r.Blit(*cmd.src_->GetPixels(), cmd.pos_) ;
+					break ;
+				}
+
+				case DrawOp::DrawString :
+					break ;
+			}
+		}
+
+	public :
+		static constexpr uint32_t DefaultTileSize = 64 ;
+
+		TileRasterizer(const TileRasterizer&) = delete ;
+		TileRasterizer& operator=(const TileRasterizer&) = delete ;
+
+		// threads 0 = std::thread::hardware_concurrency()
+		explicit TileRasterizer(uint32_t threads = 0, uint32_t tile_size = DefaultTileSize) noexcept :
+		pool_(threads), rasters_(pool_.GetThreadCount()), tile_size_(std::max(tile_size, 8u)) {}
+
+		// false bila target bukan canvas software atau list berisi command yang tidak
+		// bisa dibagi ke tile, pemanggil sebaiknya replay serial lewat Renderer.
+		bool Render(Canvas& target, const DisplayList& list) noexcept {
+			PixelBuffer* pixels = target.GetPixels() ;
+			if (!pixels) {
+				return false ;
+			}
+
+			Size size = pixels->GetSize() ;
+
+			commands_.clear() ;
+			bool supported = true ;
+			list.ForEach([&](DrawOp op, const std::byte* data) {
+				Rect bounds ;
+				if (!supported || !CommandBounds(op, data, size, bounds)) {
+					supported = false ;
+					return ;
+				}
+				commands_.push_back({op, data, bounds}) ;
+			}) ;
+
+			if (!supported) {
+				return false ;
+			}
+
+			uint32_t tiles_x = (size.x + tile_size_ - 1) / tile_size_ ;
+			uint32_t tiles_y = (size.y + tile_size_ - 1) / tile_size_ ;
+			size_t tile_count = static_cast<size_t>(tiles_x) * tiles_y ;
+			if (bins_.size() < tile_count) {
+				bins_.resize(tile_count) ;
+			}
+
+			for (size_t i = 0; i < tile_count; ++i) {
+				bins_[i].clear() ;
+			}
+
+			binned_ = 0 ;
+			for (uint32_t i = 0; i < commands_.size(); ++i) {
+				const Rect& b = commands_[i].bounds_ ;
+				int64_t x0 = std::max<int64_t>(b.x, 0) ;
+				int64_t y0 = std::max<int64_t>(b.y, 0) ;
+				int64_t x1 = std::min<int64_t>(static_cast<int64_t>(b.x) + b.w, size.x) ;
+				int64_t y1 = std::min<int64_t>(static_cast<int64_t>(b.y) + b.h, size.y) ;
+				if (x1 <= x0 || y1 <= y0) {
+					continue ;
+				}
+
+				target.MarkInvalidate(b) ;
+				for (int64_t ty = y0 / tile_size_; ty <= (y1 - 1) / tile_size_; ++ty) {
+					for (int64_t tx = x0 / tile_size_; tx <= (x1 - 1) / tile_size_; ++tx) {
+						bins_[static_cast<size_t>(ty) * tiles_x + static_cast<size_t>(tx)].push_back(i) ;
+						++binned_ ;
+					}
+				}
+			}
+
+			active_tiles_.clear() ;
+			for (uint32_t i = 0; i < tile_count; ++i) {
+				if (!bins_[i].empty()) {
+					active_tiles_.push_back(i) ;
+				}
+			}
+
+			pool_.ParallelFor(static_cast<uint32_t>(active_tiles_.size()), [&](uint32_t task, uint32_t worker) {
+				uint32_t tile = active_tiles_[task] ;
+				Rasterizer& r = rasters_[worker] ;
+				r.Bind(*pixels) ;
+				r.SetClip(Rect(static_cast<int32_t>((tile % tiles_x) * tile_size_), static_cast<int32_t>((tile / tiles_x) * tile_size_), tile_size_, tile_size_)) ;
+				for (uint32_t index : bins_[tile]) {
+					Execute(r, commands_[index].op_, commands_[index].data_) ;
+				}
+				r.Unbind() ;
+			}) ;
+
+			return true ;
+		}
+
+		uint32_t GetThreadCount() const noexcept { return pool_.GetThreadCount() ; }
+		uint32_t GetTileSize() const noexcept { return tile_size_ ; }
+
+		// jumlah pasangan (command, tile) pada Render terakhir
+		uint64_t GetBinnedCount() const noexcept { return binned_ ; }
+		size_t GetActiveTileCount() const noexcept { return active_tiles_.size() ; }
+	} ;
+}
\ No newline at end of file
@@ -304,6 +304,7 @@ struct Point_ {
 		return x * p.x + y * p.y ; 
 	}
 
+	#ifdef ZKETCH_WIN32
 	operator Gdiplus::Point() const noexcept {
 		return {
 			math_ops::apply{}.operator()<int>(x), 
@@ -345,6 +346,7 @@ struct Point_ {
 			math_ops::apply{}.operator()<short>(y)
 		} ;
 	}
+	#endif
 } ;
 
 // operator Point_ with other directly
@@ -497,6 +499,7 @@ struct Rect_ {
 		h = math_ops::apply{}.operator()<math_ops::neightbor_type_t<T>>(o.h) ;
 	}
 
+	#ifdef ZKETCH_WIN32
 	constexpr Rect_(const Gdiplus::Rect& o) noexcept {
 		x = math_ops::apply{}.operator()<T>(o.X) ;
 		y = math_ops::apply{}.operator()<T>(o.Y) ;
@@ -524,6 +527,7 @@ struct Rect_ {
 		w = math_ops::apply{}.operator()<math_ops::neightbor_type_t<T>>(o.right - o.left) ;
 		h = math_ops::apply{}.operator()<math_ops::neightbor_type_t<T>>(o.bottom - o.top) ;
 	}
+	#endif
 
 	template <typename U, typename = std::enable_if_t<std::is_arithmetic_v<U>>> 
 	constexpr Rect_& operator=(U v) noexcept {
@@ -700,6 +704,7 @@ struct Rect_ {
 		return {to.x, to.y} ;
 	}
 
+	#ifdef ZKETCH_WIN32
 	operator Gdiplus::Rect() const noexcept {
 		return {
 			math_ops::apply{}.operator()<int32_t>(x), 
@@ -735,6 +740,7 @@ struct Rect_ {
 			math_ops::apply{}.operator()<long>(y + h)
 		} ;
 	}
+	#endif
 } ;
 
 // operator Rect_ with other directly
@@ -937,6 +943,7 @@ struct Color {
 		ABGR = (ABGR & 0x00FFFFFF) | (static_cast<uint32_t>(v) << 24) ;
 	}
 
+	#ifdef ZKETCH_WIN32
 	constexpr operator COLORREF() const noexcept {
 		return (GetB() << 16) | (GetR() << 8) | GetR() ;
 	}
@@ -944,6 +951,7 @@ struct Color {
 	operator Gdiplus::Color() const noexcept {
 		return (GetA() << 24) | (GetR() << 16) | (GetG() << 8) | GetB() ;
 	}
+	#endif
 } ;
 
 using Vertex = std::vector<PointF> ;
@@ -963,6 +971,7 @@ inline std::wstring StringToWideString(const std::string& str) noexcept {
 		return L"" ;
 	}
 
+	#ifdef ZKETCH_WIN32
 	int len = MultiByteToWideChar(CP_UTF8, 0, str.data(), -1, nullptr, 0) ;
 	std::wstring wstr(len, L'\0') ;
 	MultiByteToWideChar(CP_UTF8, 0, str.data(), -1, &wstr[0], len) ;
@@ -972,6 +981,10 @@ inline std::wstring StringToWideString(const std::string& str) noexcept {
 	}
 
 	return wstr ;
+	#else
+	// headless : tanpa konversi UTF-8, byte langsung dilebarkan
+	return std::wstring(str.begin(), str.end()) ;
+	#endif
 }
 
 inline std::wstring StringToWideString(const std::string_view& str) noexcept {
@@ -983,6 +996,7 @@ inline std::string WideStringToString(const std::wstring& wstr) noexcept {
         return "" ;
     }
 
+    #ifdef ZKETCH_WIN32
     int len = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, nullptr, 0, nullptr, nullptr) ;
     if (len == 0) {
         return "" ;
@@ -992,6 +1006,15 @@ inline std::string WideStringToString(const std::wstring& wstr) noexcept {
     WideCharToMultiByte( CP_UTF8, 0, wstr.c_str(), -1, result.data(), len, nullptr, nullptr) ;
 
     return result;
+    #else
+    std::string result ;
+    result.reserve(wstr.size()) ;
+    for (wchar_t c : wstr) {
+        result.push_back(c < 0x80 ? static_cast<char>(c) : '?') ;
+    }
+
+    return result ;
+    #endif
 }
 
 }
\ No newline at end of file
@@ -1,7 +1,99 @@
 #pragma once
 #include "renderer.hpp"
+#include "spatialindex.hpp"
+#include "widgetregistry.hpp"
 
 namespace zketch {
+
+	namespace detail {
+		inline TextureAtlas*& WidgetAtlas() noexcept {
+			static TextureAtlas* atlas = nullptr ;
+			return atlas ;
+		}
+	}
+
+	// canvas widget yang dibuat setelah ini ditaruh di atlas (nullptr = canvas sendiri-sendiri).
+	// atlas harus hidup lebih lama dari semua widget yang memakainya.
+	inline void SetWidgetAtlas(TextureAtlas* atlas) noexcept { detail::WidgetAtlas() = atlas ; }
+	inline TextureAtlas* GetWidgetAtlas() noexcept { return detail::WidgetAtlas() ; }
+
+	// chrome widget (background, frame) per state visual. tiap state punya display list
+	// sendiri yang direkam sekali per key (mis. ukuran) lalu dirasterisasi sekali ke canvas
+	// sendiri, jadi redraw dan pergantian state (hover, press) cukup menyalin pixel.
+	template <size_t States>
+	class ChromeCache {
+	private :
+		struct Slot {
+			DisplayList list_ ;
+			Canvas pixels_ ;
+			bool rasterized_ = false ;
+		} ;
+
+		std::array<Slot, States> slots_ ;
+		uint64_t records_ = 0 ;
+		uint64_t rasterizes_ = 0 ;
+
+	public :
+		ChromeCache() = default ;
+		ChromeCache(const ChromeCache&) = delete ;
+		ChromeCache& operator=(const ChromeCache&) = delete ;
+
+		// record(Renderer&) hanya dipanggil bila list state ini belum direkam dengan key ini.
+		// nullptr bila canvas gagal dibuat
+		template <typename Fn>
+		const Canvas* Get(size_t state, uint64_t key, const Size& size, Fn&& record) noexcept {
+			if (state >= States || size.x == 0 || size.y == 0) {
+				return nullptr ;
+			}
+
+			Slot& slot = slots_[state] ;
+			if (!slot.list_.IsValid(key)) {
+				Renderer recorder ;
+				if (!recorder.Begin(slot.list_, key)) {
+					return nullptr ;
+				}
+				record(recorder) ;
+				recorder.End() ;
+				slot.rasterized_ = false ;
+				++records_ ;
+			}
+
+			if (slot.rasterized_ && slot.pixels_.IsValid() && slot.pixels_.GetSize() == size) {
+				return &slot.pixels_ ;
+			}
+
+			if (slot.pixels_.GetSize() != size || !slot.pixels_.IsValid()) {
+				if (!slot.pixels_.Create(size)) {
+					return nullptr ;
+				}
+			}
+
+			Renderer render ;
+			if (!render.Begin(slot.pixels_)) {
+				return nullptr ;
+			}
+			render.Clear(Transparent) ;
+			render.Replay(slot.list_) ;
+			render.End() ;
+			slot.rasterized_ = true ;
+			++rasterizes_ ;
+			return &slot.pixels_ ;
+		}
+
+		const DisplayList& GetList(size_t state) const noexcept { return slots_[state < States ? state : 0].list_ ; }
+
+		void Invalidate() noexcept {
+			for (Slot& slot : slots_) {
+				slot.list_.Invalidate() ;
+				slot.rasterized_ = false ;
+			}
+		}
+
+		// jumlah perekaman list dan rasterisasi canvas sejak dibuat
+		uint64_t GetRecordCount() const noexcept { return records_ ; }
+		uint64_t GetRasterizeCount() const noexcept { return rasterizes_ ; }
+	} ;
+
 	template <typename Derived>
     class Widget {
     protected:
@@ -9,33 +101,101 @@ namespace zketch {
         RectF bound_ ;
         bool update_ = true ;
         bool visible_ = true ;
+		SpatialGrid* index_ = nullptr ;
+		SpatialId spatial_id_ = InvalidSpatialId ;
+		WidgetRegistry* registry_ = nullptr ;
+		WidgetHandle handle_ {} ;
         
         bool IsValid() const noexcept {
             return canvas_ && canvas_->IsValid() ; 
         }
+
+		static bool CreateSurface(Canvas& canvas, const Size& size) noexcept {
+			if (TextureAtlas* atlas = GetWidgetAtlas()) {
+				return canvas.Create(size, *atlas) ;
+			}
+			return canvas.Create(size) ;
+		}
         
     public:
         Widget() noexcept = default ;
-        virtual ~Widget() noexcept = default ;
+
+        virtual ~Widget() noexcept {
+			DetachIndex() ;
+			Unregister() ;
+		}
+
+		// bound, dirty dan visibility dicerminkan ke registry, WidgetRegistry::UpdateAll
+		// menjalankan InvokeUpdate untuk widget ini
+		void Register(WidgetRegistry& registry) noexcept {
+			Unregister() ;
+			registry_ = &registry ;
+			handle_ = registry.Add(static_cast<Derived*>(this), [](void* widget) noexcept {
+				static_cast<Derived*>(widget)->InvokeUpdate() ;
+			}, bound_, visible_, update_) ;
+		}
+
+		void Unregister() noexcept {
+			if (registry_) {
+				registry_->Remove(handle_) ;
+			}
+			registry_ = nullptr ;
+			handle_ = {} ;
+		}
+
+		void MarkDirty() noexcept {
+			update_ = true ;
+			if (registry_) {
+				registry_->MarkDirty(handle_) ;
+			}
+		}
+
+		// bound widget didaftarkan ke index dan diperbarui setiap SetPosition.
+		// user data entry adalah pointer ke Derived.
+		void AttachIndex(SpatialGrid& index) noexcept {
+			DetachIndex() ;
+			index_ = &index ;
+			spatial_id_ = index.Insert(bound_, static_cast<Derived*>(this)) ;
+		}
+
+		void DetachIndex() noexcept {
+			if (index_) {
+				index_->Remove(spatial_id_) ;
+			}
+			index_ = nullptr ;
+			spatial_id_ = InvalidSpatialId ;
+		}
         
         void InvokeUpdate() noexcept { 
             if (update_ && visible_) {
                 static_cast<Derived*>(this)->UpdateImpl() ;
                 update_ = false ;
+				if (registry_) {
+					registry_->MarkDirty(handle_, false) ;
+				}
             }
         }
         
         void SetVisible(bool visible) noexcept { 
             visible_ = visible ; 
+			if (registry_) {
+				registry_->SetVisible(handle_, visible) ;
+			}
             if (visible) {
-				update_ = true ;
+				MarkDirty() ;
 			}
         }
         
         void SetPosition(const PointF& pos) noexcept {
             bound_.x = pos.x ;
             bound_.y = pos.y ;
-            update_ = true ;
+            MarkDirty() ;
+			if (index_) {
+				index_->Update(spatial_id_, bound_) ;
+			}
+			if (registry_) {
+				registry_->SetBound(handle_, bound_) ;
+			}
         }
 
 		PointF GetPosition() const noexcept { return bound_.GetPos() ; }
@@ -58,6 +218,8 @@ namespace zketch {
 		}
 
 		bool IsVisible() const noexcept { return visible_ ; }
+		SpatialId GetSpatialId() const noexcept { return spatial_id_ ; }
+		const WidgetHandle& GetHandle() const noexcept { return handle_ ; }
 		bool IsUpdate() const noexcept { return update_ ; }
     } ;
 }
\ No newline at end of file
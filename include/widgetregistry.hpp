@@ -0,0 +1,241 @@
+#pragma once
+#include "rasterizer.hpp"
+
+namespace zketch {
+
+	struct WidgetHandle {
+		static constexpr uint32_t InvalidIndex = 0xFFFFFFFF ;
+
+		uint32_t index_ = InvalidIndex ;
+		uint32_t generation_ = 0 ;
+
+		bool operator==(const WidgetHandle&) const noexcept = default ;
+	} ;
+
+	// bound, flag dirty dan visibility semua widget dalam array SoA. slot yang dilepas
+	// dipakai ulang dengan generation baru, jadi handle lama tidak valid lagi.
+	// UpdateAll() memindai bitset (dirty & visible) per 64 widget, HitTest memeriksa
+	// 4 / 8 bound sekaligus dengan SSE2 / AVX2. urutan z = urutan slot, slot terbesar di atas.
+	class WidgetRegistry {
+	public :
+		using UpdateFn = void(*)(void*) noexcept ;
+
+	private :
+		std::vector<float> x0_, y0_, x1_, y1_ ;
+		std::vector<void*> widgets_ ;
+		std::vector<UpdateFn> update_ ;
+		std::vector<uint32_t> generation_ ;
+		std::vector<uint64_t> live_, dirty_, visible_ ;
+		std::vector<uint32_t> free_ ;
+		uint32_t count_ = 0 ;
+
+		static void SetBit(std::vector<uint64_t>& bits, uint32_t i, bool on) noexcept {
+			uint64_t mask = uint64_t(1) << (i & 63) ;
+			bits[i >> 6] = on ? (bits[i >> 6] | mask) : (bits[i >> 6] & ~mask) ;
+		}
+
+		static bool GetBit(const std::vector<uint64_t>& bits, uint32_t i) noexcept {
+			return (bits[i >> 6] >> (i & 63)) & 1 ;
+		}
+
+		// mask bit bound yang berisi (px, py) untuk 64 slot mulai base
+		uint64_t HitMask(size_t base, float px, float py) const noexcept {
+			size_t end = std::min(base + 64, x0_.size()) ;
+			uint64_t mask = 0 ;
+			size_t i = base ;
+
+		#ifdef ZKETCH_SIMD_AVX2
+			__m256 vx8 = _mm256_set1_ps(px) ;
+			__m256 vy8 = _mm256_set1_ps(py) ;
+			for (; i + 8 <= end; i += 8) {
+				__m256 in = _mm256_and_ps(
+					_mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&x0_[i]), vx8, _CMP_LE_OQ), _mm256_cmp_ps(vx8, _mm256_loadu_ps(&x1_[i]), _CMP_LE_OQ)),
+					_mm256_and_ps(_mm256_cmp_ps(_mm256_loadu_ps(&y0_[i]), vy8, _CMP_LE_OQ), _mm256_cmp_ps(vy8, _mm256_loadu_ps(&y1_[i]), _CMP_LE_OQ))
+				) ;
+				mask |= static_cast<uint64_t>(_mm256_movemask_ps(in)) << (i - base) ;
+			}
+		#endif
+
+		#ifdef ZKETCH_SIMD_SSE2
+			__m128 vx4 = _mm_set1_ps(px) ;
+			__m128 vy4 = _mm_set1_ps(py) ;
+			for (; i + 4 <= end; i += 4) {
+				__m128 in = _mm_and_ps(
+					_mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&x0_[i]), vx4), _mm_cmple_ps(vx4, _mm_loadu_ps(&x1_[i]))),
+					_mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&y0_[i]), vy4), _mm_cmple_ps(vy4, _mm_loadu_ps(&y1_[i])))
+				) ;
+				mask |= static_cast<uint64_t>(_mm_movemask_ps(in)) << (i - base) ;
+			}
+		#endif
+
+			for (; i < end; ++i) {
+				if (x0_[i] <= px && px <= x1_[i] && y0_[i] <= py && py <= y1_[i]) {
+					mask |= uint64_t(1) << (i - base) ;
+				}
+			}
+			return mask ;
+		}
+
+	public :
+		WidgetRegistry(const WidgetRegistry&) = delete ;
+		WidgetRegistry& operator=(const WidgetRegistry&) = delete ;
+		WidgetRegistry() = default ;
+
+		WidgetHandle Add(void* widget, UpdateFn update, const RectF& bound, bool visible = true, bool dirty = true) noexcept {
+			uint32_t i ;
+			try {
+				if (!free_.empty()) {
+					i = free_.back() ;
+					free_.pop_back() ;
+				} else {
+					i = static_cast<uint32_t>(x0_.size()) ;
+					x0_.push_back(0.0f) ;
+					y0_.push_back(0.0f) ;
+					x1_.push_back(0.0f) ;
+					y1_.push_back(0.0f) ;
+					widgets_.push_back(nullptr) ;
+					update_.push_back(nullptr) ;
+					generation_.push_back(0) ;
+					if ((i >> 6) >= live_.size()) {
+						live_.push_back(0) ;
+						dirty_.push_back(0) ;
+						visible_.push_back(0) ;
+					}
+				}
+			} catch (...) {
+
+				#ifdef WIDGET_DEBUG
+					logger::error("WidgetRegistry::Add - Out of memory.") ;
+				#endif
+
+				return {} ;
+			}
+
+			widgets_[i] = widget ;
+			update_[i] = update ;
+			SetBit(live_, i, true) ;
+			++count_ ;
+
+			WidgetHandle handle {i, generation_[i]} ;
+			SetBound(handle, bound) ;
+			SetVisible(handle, visible) ;
+			SetBit(dirty_, i, dirty) ;
+			return handle ;
+		}
+
+		void Remove(const WidgetHandle& handle) noexcept {
+			if (!IsValid(handle)) {
+				return ;
+			}
+
+			uint32_t i = handle.index_ ;
+			++generation_[i] ;
+			SetBit(live_, i, false) ;
+			SetBit(dirty_, i, false) ;
+			SetBit(visible_, i, false) ;
+			widgets_[i] = nullptr ;
+			update_[i] = nullptr ;
+			// bound kosong (NaN) supaya HitTest tidak pernah mengenai slot ini
+			x0_[i] = y0_[i] = x1_[i] = y1_[i] = std::numeric_limits<float>::quiet_NaN() ;
+			--count_ ;
+			try {
+				free_.push_back(i) ;
+			} catch (...) {}
+		}
+
+		bool IsValid(const WidgetHandle& handle) const noexcept {
+			return handle.index_ < generation_.size() && generation_[handle.index_] == handle.generation_ && GetBit(live_, handle.index_) ;
+		}
+
+		void SetBound(const WidgetHandle& handle, const RectF& bound) noexcept {
+			if (!IsValid(handle)) {
+				return ;
+			}
+
+			uint32_t i = handle.index_ ;
+			x0_[i] = std::min(bound.x, bound.x + bound.w) ;
+			y0_[i] = std::min(bound.y, bound.y + bound.h) ;
+			x1_[i] = std::max(bound.x, bound.x + bound.w) ;
+			y1_[i] = std::max(bound.y, bound.y + bound.h) ;
+		}
+
+		void SetVisible(const WidgetHandle& handle, bool visible) noexcept {
+			if (IsValid(handle)) {
+				SetBit(visible_, handle.index_, visible) ;
+			}
+		}
+
+		void MarkDirty(const WidgetHandle& handle, bool dirty = true) noexcept {
+			if (IsValid(handle)) {
+				SetBit(dirty_, handle.index_, dirty) ;
+			}
+		}
+
+		// panggil update untuk semua widget dirty & visible, return jumlahnya.
+		// bit dirty dibersihkan sebelum update, widget boleh menandai dirty lagi.
+		size_t UpdateAll() noexcept {
+			size_t updated = 0 ;
+			for (size_t w = 0; w < dirty_.size(); ++w) {
+				uint64_t bits = dirty_[w] & visible_[w] & live_[w] ;
+				while (bits) {
+					uint32_t i = static_cast<uint32_t>(w * 64 + std::countr_zero(bits)) ;
+					bits &= bits - 1 ;
+					SetBit(dirty_, i, false) ;
+					update_[i](widgets_[i]) ;
+					++updated ;
+				}
+			}
+			return updated ;
+		}
+
+		// widget visible paling atas yang berisi p, handle invalid bila tidak ada
+		WidgetHandle HitTest(const PointF& p) const noexcept {
+			for (size_t w = live_.size(); w-- > 0;) {
+				uint64_t bits = HitMask(w * 64, p.x, p.y) & visible_[w] & live_[w] ;
+				if (bits) {
+					uint32_t i = static_cast<uint32_t>(w * 64 + 63 - std::countl_zero(bits)) ;
+					return {i, generation_[i]} ;
+				}
+			}
+			return {} ;
+		}
+
+		// semua widget visible yang berisi p, atas ke bawah
+		void HitTestAll(const PointF& p, std::vector<WidgetHandle>& out) const {
+			out.clear() ;
+			for (size_t w = live_.size(); w-- > 0;) {
+				uint64_t bits = HitMask(w * 64, p.x, p.y) & visible_[w] & live_[w] ;
+				while (bits) {
+					uint32_t i = static_cast<uint32_t>(w * 64 + 63 - std::countl_zero(bits)) ;
+					bits &= ~(uint64_t(1) << (i & 63)) ;
+					out.push_back({i, generation_[i]}) ;
+				}
+			}
+		}
+
+		// ada widget dirty & visible
+		bool HasDirty() const noexcept {
+			for (size_t w = 0; w < dirty_.size(); ++w) {
+				if (dirty_[w] & visible_[w] & live_[w]) {
+					return true ;
+				}
+			}
+			return false ;
+		}
+
+		void* GetWidget(const WidgetHandle& handle) const noexcept { return IsValid(handle) ? widgets_[handle.index_] : nullptr ; }
+		bool IsDirty(const WidgetHandle& handle) const noexcept { return IsValid(handle) && GetBit(dirty_, handle.index_) ; }
+		bool IsVisible(const WidgetHandle& handle) const noexcept { return IsValid(handle) && GetBit(visible_, handle.index_) ; }
+
+		RectF GetBound(const WidgetHandle& handle) const noexcept {
+			if (!IsValid(handle)) {
+				return {} ;
+			}
+			uint32_t i = handle.index_ ;
+			return RectF{x0_[i], y0_[i], x1_[i] - x0_[i], y1_[i] - y0_[i]} ;
+		}
+
+		uint32_t GetCount() const noexcept { return count_ ; }
+		size_t GetCapacity() const noexcept { return x0_.size() ; }
+	} ;
+}
\ No newline at end of file
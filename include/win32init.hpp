@@ -1,4 +1,6 @@
 #pragma once
 
-#include <windows.h>
-#include <windowsx.h>
\ No newline at end of file
+#ifdef ZKETCH_WIN32
+	#include <windows.h>
+	#include <windowsx.h>
+#endif
\ No newline at end of file
@@ -1,11 +1,24 @@
 #pragma once
 #include "canvas.hpp"
+#include "present.hpp"
 #include "event.hpp"
+#include "framepacer.hpp"
+#include "widgetregistry.hpp"
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+	#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
 
 namespace zketch {
 
 	inline LRESULT CALLBACK wndproc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) ;
 
+	struct FrameInfo {
+		uint64_t index_ = 0 ;
+		double delta_ms_ = 0.0 ; // sejak awal frame sebelumnya
+		uint64_t skipped_ = 0 ;  // total deadline yang terlewat
+	} ;
+
 	class Application {
 		friend inline LRESULT CALLBACK wndproc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) ;
 		friend class Window ;
@@ -13,6 +26,23 @@ namespace zketch {
 	private :
 		static inline std::unordered_map<HWND, Window*> g_windows_ ;
 		static inline bool app_is_runing_ = true ;
+		static inline bool frame_requested_ = false ;
+		static inline FrameHistogram frame_times_ {} ;
+		static inline FrameHistogram frame_intervals_ {} ;
+		static inline uint64_t skipped_frames_ = 0 ;
+		// sumber dirty untuk Run, hanya thread UI
+		static inline std::vector<const WidgetRegistry*> dirty_registries_ ;
+		static inline std::function<bool()> dirty_check_ {} ;
+		static inline std::function<void(const Event&)> input_handler_ {} ;
+
+		static HANDLE CreateFrameTimer() noexcept {
+			HANDLE timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS) ;
+			if (!timer) {
+				// sebelum Windows 10 1803 : timer biasa, resolusi mengikuti timer sistem
+				timer = CreateWaitableTimer(nullptr, FALSE, nullptr) ;
+			}
+			return timer ;
+		}
 
 		static void RegisterWindow(HWND hwnd, Window* window) noexcept {
 			if (hwnd && window) {
@@ -71,6 +101,163 @@ namespace zketch {
 		static bool IsRunning() noexcept {
 			return app_is_runing_ ;
 		}
+
+		// loop utama pengganti while + Sleep(16). frame(info) dipanggil paling cepat sekali
+		// per 1 / fps detik dan hanya bila ada yang dirty (IsDirty), RequestFrame(), atau
+		// deadline ScheduleWake tercapai (continuous = true : setiap deadline). pesan OS
+		// tanpa efek (WM_TIMER, WM_PAINT, hover di atas widget statis, ...) tidak memicu frame.
+		// event zketch diserahkan ke SetInputHandler bila ada; tanpa handler, event yang
+		// tertunda ikut meminta frame karena frame() yang harus mengambilnya.
+		// tanpa frame yang tertunda thread tidur di MsgWaitForMultipleObjects sampai ada
+		// input atau deadline ScheduleWake, di antara frame menunggu waitable timer resolusi tinggi.
+		static void Run(const std::function<void(const FrameInfo&)>& frame, double fps = 60.0, bool continuous = false) {
+			if (!frame) {
+				return ;
+			}
+
+			using Clock = FramePacer::Clock ;
+
+			HANDLE timer = CreateFrameTimer() ;
+			HANDLE wake = EventSystem::GetWakeHandle() ;
+			FramePacer pacer(fps) ;
+			FrameInfo info ;
+			Clock::time_point last_start {} ;
+			bool armed = false ;
+			frame_requested_ = true ;
+
+			while (app_is_runing_) {
+				bool quit ;
+				PumpMessages(quit) ;
+
+				if (quit) {
+					app_is_runing_ = false ;
+					break ;
+				}
+
+				if (input_handler_) {
+					Event e ;
+					while (EventSystem::PollEvent(e)) {
+						input_handler_(e) ;
+					}
+				} else if (EventSystem::HasPending()) {
+					frame_requested_ = true ;
+				}
+
+				if (EventSystem::GetScheduledWake() <= Clock::now()) {
+					EventSystem::ClearScheduledWake() ;
+					frame_requested_ = true ;
+				}
+
+				if (!frame_requested_ && IsDirty()) {
+					frame_requested_ = true ;
+				}
+
+				if (!frame_requested_ && !continuous) {
+					pacer.Reset() ;
+
+					DWORD idle = INFINITE ;
+					Clock::time_point until = EventSystem::GetScheduledWake() ;
+					if (until != Clock::time_point::max()) {
+						auto ms = std::chrono::ceil<std::chrono::milliseconds>(until - Clock::now()).count() ;
+						idle = static_cast<DWORD>(std::clamp<int64_t>(ms, 0, INFINITE - 1)) ;
+					}
+
+					MsgWaitForMultipleObjectsEx(wake ? 1 : 0, wake ? &wake : nullptr, idle, QS_ALLINPUT, MWMO_INPUTAVAILABLE) ;
+					continue ;
+				}
+
+				Clock::time_point now = Clock::now() ;
+				if (!pacer.IsDue(now)) {
+					DWORD timeout = INFINITE ;
+					if (timer && !armed) {
+						// relatif, satuan 100 ns
+						LARGE_INTEGER due ;
+						due.QuadPart = -std::max<LONGLONG>(std::chrono::duration_cast<std::chrono::nanoseconds>(pacer.GetRemaining(now)).count() / 100, 1) ;
+						armed = SetWaitableTimer(timer, &due, 0, nullptr, nullptr, FALSE) != FALSE ;
+					}
+
+					if (!armed) {
+						timeout = static_cast<DWORD>(std::chrono::ceil<std::chrono::milliseconds>(pacer.GetRemaining(now)).count()) ;
+					}
+
+					// timer (bila aktif) selalu di index 0
+					HANDLE handles[2] ;
+					DWORD count = 0 ;
+					if (armed) {
+						handles[count++] = timer ;
+					}
+					if (wake) {
+						handles[count++] = wake ;
+					}
+
+					if (MsgWaitForMultipleObjectsEx(count, count ? handles : nullptr, timeout, QS_ALLINPUT, MWMO_INPUTAVAILABLE) == WAIT_OBJECT_0 && armed) {
+						armed = false ;
+					}
+					continue ;
+				}
+
+				if (armed) {
+					CancelWaitableTimer(timer) ;
+					armed = false ;
+				}
+
+				frame_requested_ = false ;
+				info.delta_ms_ = info.index_ ? std::chrono::duration<double, std::milli>(now - last_start).count() : 0.0 ;
+				info.skipped_ = pacer.GetSkipped() ;
+
+				// jarak setelah idle bukan jitter, tidak dicatat
+				if (pacer.IsStarted()) {
+					frame_intervals_.Record(info.delta_ms_) ;
+				}
+				last_start = now ;
+
+				frame(info) ;
+
+				frame_times_.Record(std::chrono::duration<double, std::milli>(Clock::now() - now).count()) ;
+				pacer.Advance(now) ;
+				skipped_frames_ = pacer.GetSkipped() ;
+				++info.index_ ;
+			}
+
+			if (timer) {
+				CloseHandle(timer) ;
+			}
+		}
+
+		// minta frame berikutnya walau tidak ada input (animasi, caret berkedip, ...)
+		static void RequestFrame() noexcept { frame_requested_ = true ; }
+
+		// widget dirty & visible di registry ini meminta frame. registry harus hidup
+		// sampai RemoveDirtySource
+		static void AddDirtySource(const WidgetRegistry& registry) {
+			if (std::find(dirty_registries_.begin(), dirty_registries_.end(), &registry) == dirty_registries_.end()) {
+				dirty_registries_.push_back(&registry) ;
+			}
+		}
+
+		static void RemoveDirtySource(const WidgetRegistry& registry) noexcept {
+			std::erase(dirty_registries_, &registry) ;
+		}
+
+		// pemeriksaan dirty tambahan milik aplikasi (canvas custom, model data, ...)
+		static void SetDirtyCheck(std::function<bool()> check) noexcept { dirty_check_ = std::move(check) ; }
+
+		// event diambil Run dan diteruskan ke sini, di luar frame. nullptr = frame() yang mengambil
+		static void SetInputHandler(std::function<void(const Event&)> handler) noexcept { input_handler_ = std::move(handler) ; }
+
+		// ada window dengan damage yang belum di-present, widget dirty di registry
+		// terdaftar, atau dirty check aplikasi mengembalikan true
+		static bool IsDirty() ;
+
+		// durasi callback frame dan jarak antar awal frame, dalam ms
+		static const FrameHistogram& GetFrameTimes() noexcept { return frame_times_ ; }
+		static const FrameHistogram& GetFrameIntervals() noexcept { return frame_intervals_ ; }
+		static uint64_t GetSkippedFrames() noexcept { return skipped_frames_ ; }
+
+		static void ResetFrameStats() noexcept {
+			frame_times_.Reset() ;
+			frame_intervals_.Reset() ;
+		}
 	} ;
 
 	namespace AppRegistry {
@@ -142,9 +329,29 @@ namespace zketch {
 		std::unique_ptr<Canvas> back_buffer_ ;
 		WindowState state_ = WindowState::None ;
 		bool close_requested_ = false ;
+		bool in_size_move_ = false ;
+
+		// area tempat front dan back buffer berbeda sejak swap terakhir. Renderer menyalinnya
+		// ke back buffer sebelum frame berikutnya, jadi present cukup memakai damage front.
+		DamageRegion frame_damage_ {} ;
+		std::vector<Rect> present_rects_ ;
+		PresentStats last_present_ {} ;
+		float present_threshold_ = DefaultPresentThreshold ;
+		std::unique_ptr<PresentTarget> present_target_ {} ;
+		LatencyTracker latency_ {} ;
+		bool track_latency_ = false ;
+
+		static void ObserveInput(const Event& e) noexcept {
+			auto it = Application::g_windows_.find(e.GetHandle()) ;
+			if (it != Application::g_windows_.end() && it->second->track_latency_) {
+				it->second->latency_.Input(e.GetTimeStamp()) ;
+			}
+		}
 
 		void CreateCanvas(const Size& size) noexcept {
 			if ((state_ & WindowState::Destroyed) != WindowState::Destroyed) {
+				frame_damage_.Clear() ;
+
 				if (!front_buffer_) {
 					front_buffer_ = std::make_unique<Canvas>() ;
 				}
@@ -173,6 +380,49 @@ namespace zketch {
 			}
 		}
 
+		// selama live resize buffer lama dipakai selama muat, dan bila harus tumbuh
+		// dialokasi dengan kelonggaran ResizeHeadroom. ukuran 0 (minimize) diabaikan.
+		void ResizeCanvas(const Size& size) noexcept {
+			if ((state_ & WindowState::Destroyed) == WindowState::Destroyed || size.x == 0 || size.y == 0) {
+				return ;
+			}
+
+			if (!front_buffer_ || !back_buffer_) {
+				CreateCanvas(size) ;
+				return ;
+			}
+
+			Size reserve = size ;
+			if (in_size_move_) {
+				reserve.x = (size.x + ResizeHeadroom - 1) / ResizeHeadroom * ResizeHeadroom ;
+				reserve.y = (size.y + ResizeHeadroom - 1) / ResizeHeadroom * ResizeHeadroom ;
+			}
+
+			frame_damage_.Clear() ;
+			if (!front_buffer_->Resize(size, reserve) || !back_buffer_->Resize(size, reserve)) {
+
+				#ifdef WINDOW_DEBUG
+					logger::error("Window::ResizeCanvas - failed to resize buffers to [", size.x, "x", size.y, "].") ;
+				#endif
+
+			}
+		}
+
+		// resize selesai : lepas kelebihan storage, isi buffer tetap
+		void FitCanvas() noexcept {
+			if (!IsCanvasValid()) {
+				return ;
+			}
+
+			if (!front_buffer_->Fit() || !back_buffer_->Fit()) {
+
+				#ifdef WINDOW_DEBUG
+					logger::warning("Window::FitCanvas - failed to shrink buffers, keeping the larger ones.") ;
+				#endif
+
+			}
+		}
+
 		bool IsCanvasValid() const noexcept {
     		return front_buffer_ && back_buffer_ && front_buffer_->IsValid() && back_buffer_->IsValid() && ((state_ & WindowState::Destroyed) != WindowState::Destroyed) ;
 		}
@@ -211,6 +461,8 @@ namespace zketch {
 		}
 
 	public :
+		static constexpr uint32_t ResizeHeadroom = 256 ;
+
 		Window(const Window&) = delete ;
 		Window& operator=(const Window&) = delete ;
 
@@ -289,12 +541,22 @@ namespace zketch {
 		front_buffer_(std::move(o.front_buffer_)), 
 		back_buffer_(std::move(o.back_buffer_)),
 		state_(std::exchange(o.state_, WindowState::None)),
-		close_requested_(std::exchange(o.close_requested_, false)) {
+		close_requested_(std::exchange(o.close_requested_, false)),
+		in_size_move_(std::exchange(o.in_size_move_, false)),
+		frame_damage_(std::move(o.frame_damage_)),
+		present_rects_(std::move(o.present_rects_)),
+		last_present_(o.last_present_),
+		present_threshold_(o.present_threshold_),
+		present_target_(std::move(o.present_target_)),
+		latency_(o.latency_),
+		track_latency_(std::exchange(o.track_latency_, false)) {
 
 			#ifdef WINDOW_DEBUG
 				logger::info("Window::Window - Calling move ctor.") ;
 			#endif
 
+			o.latency_.Reset() ;
+
 			if (handle_) {
 				Application::UnRegisterWindow(handle_) ;
 				Application::RegisterWindow(handle_, this) ;
@@ -322,6 +584,15 @@ namespace zketch {
 				back_buffer_ = std::move(o.back_buffer_) ;
 				state_ = std::exchange(o.state_, WindowState::None) ;
 				close_requested_ = std::exchange(o.close_requested_, false) ;
+				in_size_move_ = std::exchange(o.in_size_move_, false) ;
+				frame_damage_ = std::move(o.frame_damage_) ;
+				present_rects_ = std::move(o.present_rects_) ;
+				last_present_ = o.last_present_ ;
+				present_threshold_ = o.present_threshold_ ;
+				present_target_ = std::move(o.present_target_) ;
+				latency_ = o.latency_ ;
+				track_latency_ = std::exchange(o.track_latency_, false) ;
+				o.latency_.Reset() ;
 
 				if (handle_) {
 					Application::UnRegisterWindow(handle_) ;
@@ -380,53 +651,74 @@ namespace zketch {
 			InternalDestroy() ;
 		}
 
-		void Present() const noexcept {
+		// hanya area yang berubah sejak present terakhir yang disalin ke layar. tanpa target
+		// custom, buffer software dikirim lewat DibPresentTarget dan GDI+ lewat DrawImage.
+		PresentStats Present(bool full = false) noexcept {
 			if (!front_buffer_ || !front_buffer_->IsValid()) {
 
 				#ifdef WINDOW_DEBUG
 					logger::warning("Window::Present - Invalid canvas!") ;
 				#endif
 
-				return ;
+				return {} ;
 			}
 
-			HDC hdc = GetDC(handle_) ;
-			if (!hdc) {
-
-				#ifdef WINDOW_DEBUG
-					logger::warning("Window::Present - Invalid HDC!") ;
-				#endif
-				
-				return ;
+			if (full) {
+				front_buffer_->MarkInvalidate() ;
 			}
 
-			Gdiplus::Graphics screen(hdc) ;
-			if (screen.GetLastStatus() != Gdiplus::Ok) {
+			if (present_target_) {
+				last_present_ = PresentRegion(*front_buffer_, front_buffer_->GetDamage(), *present_target_, present_threshold_, present_rects_) ;
+			} else if (front_buffer_->IsSoftware()) {
+				DibPresentTarget target(handle_) ;
+				last_present_ = PresentRegion(*front_buffer_, front_buffer_->GetDamage(), target, present_threshold_, present_rects_) ;
+			} else {
+				WindowPresentTarget target(handle_) ;
+				last_present_ = PresentRegion(*front_buffer_, front_buffer_->GetDamage(), target, present_threshold_, present_rects_) ;
+			}
 
-				#ifdef WINDOW_DEBUG
-					logger::error("Window::Present - Graphics creation failed");
-				#endif
+			// present yang gagal (mis. GetDC gagal) menyimpan damage untuk present berikutnya
+			if (last_present_.presented_) {
+				front_buffer_->MarkValidate() ;
+			}
 
-				ReleaseDC(handle_, hdc);
-				return;
+			if (track_latency_) {
+				latency_.Present(EventClockNow(), last_present_.full_ || last_present_.rect_count_ > 0) ;
 			}
 
-			screen.SetCompositingMode(Gdiplus::CompositingModeSourceOver) ;
-			screen.SetCompositingQuality(Gdiplus::CompositingQualityHighSpeed) ;
-			screen.SetInterpolationMode(Gdiplus::InterpolationModeNearestNeighbor) ;
-			auto status = screen.DrawImage(front_buffer_->GetBitmap(), 0, 0) ;
+			#ifdef WINDOW_DEBUG
+				logger::info("Window::Present - Copied ", last_present_.bytes_copied_, " bytes in ", last_present_.rect_count_, " rect(s).") ;
+			#endif
+
+			return last_present_ ;
+		}
 
-			if (status != Gdiplus::Ok) {
+		// rasio luas damage terhadap canvas, di atasnya present menyalin seluruh canvas
+		void SetPresentThreshold(float threshold) noexcept { present_threshold_ = std::clamp(threshold, 0.0f, 1.0f) ; }
+		float GetPresentThreshold() const noexcept { return present_threshold_ ; }
 
-				#ifdef WINDOW_DEBUG
-					logger::error("Window::Present - DrawImage failed: ", static_cast<int>(status));
-				#endif
-				
-			}
+		// nullptr kembali ke target bawaan
+		void SetPresentTarget(std::unique_ptr<PresentTarget> target) noexcept { present_target_ = std::move(target) ; }
+		PresentTarget* GetPresentTarget() const noexcept { return present_target_.get() ; }
+		const PresentStats& GetPresentStats() const noexcept { return last_present_ ; }
 
-			ReleaseDC(handle_, hdc) ;
+		// frame sudah dirender tapi belum di-present
+		bool HasPendingPresent() const noexcept {
+			return front_buffer_ && front_buffer_->IsValid() && !front_buffer_->GetDamage().IsEmpty() ;
 		}
 
+		// latensi input-to-present window ini (lihat LatencyTracker), default mati
+		void SetLatencyTracking(bool enable) noexcept {
+			track_latency_ = enable ;
+			if (enable) {
+				EventSystem::SetInputObserver(&Window::ObserveInput) ;
+			}
+		}
+
+		bool IsLatencyTracking() const noexcept { return track_latency_ ; }
+		const LatencyTracker& GetLatency() const noexcept { return latency_ ; }
+		void ResetLatency() noexcept { latency_.Reset() ; }
+
 		void SetTitle(const char* title) noexcept {
 			if (handle_) {
 				SetWindowText(handle_, title) ;
@@ -450,17 +742,50 @@ namespace zketch {
 		bool IsCloseRequested() const noexcept { return close_requested_ ; }
 	} ;
 
+	inline bool Application::IsDirty() {
+		for (auto& w : g_windows_) {
+			if (w.second && w.second->HasPendingPresent()) {
+				return true ;
+			}
+		}
+
+		for (const WidgetRegistry* registry : dirty_registries_) {
+			if (registry->HasDirty()) {
+				return true ;
+			}
+		}
+
+		return dirty_check_ && dirty_check_() ;
+	}
+
 	inline LRESULT CALLBACK wndproc(HWND hwnd, UINT msg, WPARAM wp, LPARAM lp) {
 		switch (msg) {
 			case WM_SIZE : {
 				auto it = Application::g_windows_.find(hwnd) ;
 				if (it != Application::g_windows_.end()) {
-					it->second->CreateCanvas({LOWORD(lp), HIWORD(lp)}) ;
+					it->second->ResizeCanvas({LOWORD(lp), HIWORD(lp)}) ;
 				} 
 				EventSystem::PushEvent(Event::CreateResizeEvent(hwnd, {LOWORD(lp), HIWORD(lp)})) ;
 				break ;
 			}
 
+			case WM_ENTERSIZEMOVE : {
+				auto it = Application::g_windows_.find(hwnd) ;
+				if (it != Application::g_windows_.end()) {
+					it->second->in_size_move_ = true ;
+				}
+				break ;
+			}
+
+			case WM_EXITSIZEMOVE : {
+				auto it = Application::g_windows_.find(hwnd) ;
+				if (it != Application::g_windows_.end()) {
+					it->second->in_size_move_ = false ;
+					it->second->FitCanvas() ;
+				}
+				break ;
+			}
+
 			case WM_CLOSE : {
 				EventSystem::PushEvent(Event::CreateCommonEvent(hwnd, EventType::Close)) ;
 				
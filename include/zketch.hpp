@@ -1,14 +1,27 @@
 #pragma once
 #include "renderer.hpp"
-#include "inputsystem.hpp"
-#include "slider.hpp"
-#include "button.hpp"
-#include "textbox.hpp"
-#include "inputbox.hpp"
+#include "present.hpp"
+#include "compositor.hpp"
+#include "spatialindex.hpp"
+#include "widgetregistry.hpp"
+#include "framepacer.hpp"
+#include "latency.hpp"
+#include "mpscring.hpp"
+
+#ifdef ZKETCH_WIN32
+	#include "inputsystem.hpp"
+	#include "dispatcher.hpp"
+	#include "slider.hpp"
+	#include "button.hpp"
+	#include "textbox.hpp"
+	#include "inputbox.hpp"
+#endif
 
 namespace zketch {
+#ifdef ZKETCH_WIN32
 	void zketch_init() noexcept {
 		AppRegistry::RegisterWindowClass() ;
 		EventSystem::Init() ;
 	}
+#endif
 }
\ No newline at end of file
@@ -16,17 +16,16 @@ int main() {
 	// this method using for showing window
 	window.Show() ;
 
-	// Create Event buffer
-	Event e ;
+	// main loop : Run sleeps until there is input, then calls this lambda
+	// at most 60 times per second (no while + Sleep(16) needed)
+	Application::Run([](const FrameInfo&) {
 
-	while(Application) {
+		// Create Event buffer
+		Event e ;
 
-		// push event to event queue
+		// take events from event queue
 		while(PollEvent(e)) {
 
 		}
-		
-		// delay 16 ms equal 60 FPS
-		Sleep(16) ;
-	}
+	}) ;
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+// pemeriksaan headless untuk FlattenRoundedRect dan GeometryCache, tanpa window.
+// return 0 bila semua lolos.
+#include "geometry.hpp"
+
+using namespace zketch ;
+
+static int failed = 0 ;
+
+static void Check(bool ok, const char* what) {
+	if (!ok) {
+		logger::error("FAIL - ", what) ;
+		++failed ;
+	}
+}
+
+static void CheckRadiusClamp() {
+	Vertex out ;
+	FlattenRoundedRect(20.0f, 10.0f, 100.0f, 0.0f, out) ;
+	Check(!out.empty(), "clamp : outline not empty") ;
+
+	bool inside = true ;
+	for (const PointF& p : out) {
+		inside = inside && p.x >= -1e-3f && p.x <= 20.001f && p.y >= -1e-3f && p.y <= 10.001f ;
+	}
+	Check(inside, "clamp : outline stays inside the rect") ;
+
+	// radius jadi min(w, h) / 2 = 5, titik pertama (sudut 180) di (0, 5)
+	Check(std::fabs(out.front().x) < 1e-3f && std::fabs(out.front().y - 5.0f) < 1e-3f, "clamp : radius clamped to min(w, h) / 2") ;
+
+	FlattenRoundedRect(20.0f, 10.0f, 0.0f, 0.0f, out) ;
+	Check(out.size() == 4, "clamp : zero radius gives a plain rect") ;
+
+	FlattenRoundedRect(0.0f, 10.0f, 2.0f, 0.0f, out) ;
+	Check(out.empty(), "clamp : empty rect gives no outline") ;
+}
+
+static void CheckChordError() {
+	const float tolerance = 0.25f ;
+	const float radii[] = {1.0f, 3.0f, 8.0f, 25.0f, 80.0f, 400.0f} ;
+	Vertex out ;
+
+	for (float r : radii) {
+		float w = r * 2.0f + 10.0f ;
+		FlattenRoundedRect(w, w, r, 0.0f, out, tolerance) ;
+		uint32_t n = ArcSegments(r, tolerance) ;
+		Check(out.size() == 4 * (n + 1), "chord : point count matches ArcSegments") ;
+
+		// sudut kiri atas, pusat (r, r) : titik tengah tiap chord berjarak paling jauh
+		// tolerance dari busur (batas 64 segmen boleh melampaui untuk radius besar)
+		float worst = 0.0f ;
+		for (uint32_t i = 0; i < n; ++i) {
+			PointF a = out[i] ;
+			PointF b = out[i + 1] ;
+			float mx = (a.x + b.x) * 0.5f - r ;
+			float my = (a.y + b.y) * 0.5f - r ;
+			worst = std::max(worst, r - std::sqrt(mx * mx + my * my)) ;
+		}
+
+		if (n < 64) {
+			Check(worst <= tolerance + 1e-3f, "chord : sagitta within tolerance") ;
+		}
+	}
+}
+
+static void CheckCache() {
+	GeometryCache cache(2) ;
+
+	const Vertex& a = cache.GetRoundedRect(40.0f, 20.0f, 6.0f) ;
+	Check(!a.empty(), "cache : outline built") ;
+	cache.GetRoundedRect(40.0f, 20.0f, 6.0f) ;
+	Check(cache.GetHits() == 1 && cache.GetMisses() == 1, "cache : second lookup hits") ;
+
+	cache.GetRoundedRect(50.0f, 20.0f, 6.0f) ;
+	cache.GetRoundedRect(60.0f, 20.0f, 6.0f) ;
+	Check(cache.GetSize() == 2, "cache : size capped at capacity") ;
+
+	// 40x20 sudah tergusur
+	cache.ResetStats() ;
+	cache.GetRoundedRect(40.0f, 20.0f, 6.0f) ;
+	Check(cache.GetMisses() == 1, "cache : evicted entry misses") ;
+
+	// -0.0f dan +0.0f key yang sama
+	cache.ResetStats() ;
+	cache.GetRoundedRect(40.0f, 20.0f, 6.0f, -0.0f) ;
+	Check(cache.GetHits() == 1, "cache : -0.0f hits +0.0f entry") ;
+
+	// NaN tidak masuk cache dan tidak merusak eviction
+	Check(cache.GetRoundedRect(10.0f, 10.0f, 2.0f, NAN).empty(), "cache : NaN gives empty outline") ;
+	Check(cache.GetRoundedRect(NAN, 10.0f, 2.0f).empty(), "cache : NaN width gives empty outline") ;
+	cache.GetRoundedRect(70.0f, 20.0f, 6.0f) ;
+	cache.GetRoundedRect(80.0f, 20.0f, 6.0f) ;
+	Check(cache.GetSize() == 2, "cache : eviction still works after NaN input") ;
+}
+
+int main() {
+	CheckRadiusClamp() ;
+	CheckChordError() ;
+	CheckCache() ;
+
+	if (failed) {
+		logger::error(failed, " check(s) failed") ;
+		return 1 ;
+	}
+
+	logger::info("geometry checks passed") ;
+	return 0 ;
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+// benchmark headless TileRasterizer : satu display list 4K dirender serial lalu
+// dengan 1 / 2 / 4 / 8 thread. hasil tiap jumlah thread dibandingkan byte per byte
+// dengan render serial. speedup baru berarti di mesin dengan core sebanyak thread-nya.
+// argumen opsional : jumlah widget (default 4000), jumlah frame per ukuran (default 10)
+#include "zketch.hpp"
+
+using namespace zketch ;
+
+static void BuildScene(DisplayList& dl, uint32_t w, uint32_t h, int widgets) {
+	Renderer rec ;
+	rec.Begin(dl) ;
+	rec.Clear(White) ;
+
+	uint32_t seed = 11 ;
+	auto rnd = [&](uint32_t m) {
+		seed = seed * 1103515245u + 12345u ;
+		return (seed >> 8) % m ;
+	} ;
+
+	for (int i = 0; i < widgets; ++i) {
+		float x = static_cast<float>(rnd(w - 120)) ;
+		float y = static_cast<float>(rnd(h - 40)) ;
+		Color c(rgba8(static_cast<uint8_t>(rnd(255)), static_cast<uint8_t>(rnd(255)), static_cast<uint8_t>(rnd(255)), static_cast<uint8_t>(128 + rnd(127)))) ;
+		rec.FillRectRounded({x, y, 110, 32}, c, 6.0f) ;
+		rec.DrawRectRounded({x, y, 110, 32}, Black, 6.0f, 2.0f) ;
+		rec.FillEllipse({x + 4, y + 4, 24, 24}, Red) ;
+		rec.DrawLine(Point{static_cast<int32_t>(x), static_cast<int32_t>(y + 31)}, Point{static_cast<int32_t>(x + 109), static_cast<int32_t>(y)}, Blue, 1.5f) ;
+		rec.FillPolygon({{x + 40, y + 5}, {x + 60, y + 28}, {x + 80, y + 5}}, Green) ;
+	}
+	rec.End() ;
+}
+
+template <typename Fn>
+static double TimeFrames(int frames, Fn&& fn) {
+	fn() ; // pemanasan
+	auto t0 = std::chrono::steady_clock::now() ;
+	for (int i = 0; i < frames; ++i) {
+		fn() ;
+	}
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count() / frames ;
+}
+
+int main(int argc, char** argv) {
+	int widgets = argc > 1 ? std::max(1, std::atoi(argv[1])) : 4000 ;
+	int frames = argc > 2 ? std::max(1, std::atoi(argv[2])) : 10 ;
+	const Size size {3840, 2160} ;
+
+	DisplayList dl ;
+	BuildScene(dl, size.x, size.y, widgets) ;
+
+	Canvas serial ;
+	if (!serial.Create(size)) {
+		logger::error("test12 - canvas creation failed") ;
+		return 1 ;
+	}
+
+	double serial_ms = TimeFrames(frames, [&] {
+		Renderer r ;
+		r.Begin(serial) ;
+		r.Replay(dl) ;
+		r.End() ;
+	}) ;
+
+	std::printf("hardware threads : %u\n", std::thread::hardware_concurrency()) ;
+	std::printf("%d widgets, %zu commands, %ux%u\n", widgets, dl.GetCommandCount(), size.x, size.y) ;
+	std::printf("serial           %8.2f ms/frame\n", serial_ms) ;
+
+	int failed = 0 ;
+	Canvas tiled ;
+	tiled.Create(size) ;
+	for (uint32_t threads : {1u, 2u, 4u, 8u}) {
+		TileRasterizer tiles(threads) ;
+		double ms = TimeFrames(frames, [&] {
+			Renderer r ;
+			r.Begin(tiled) ;
+			r.Replay(dl, tiles) ;
+			r.End() ;
+		}) ;
+
+		bool same = std::memcmp(tiled.GetPixels()->GetData(), serial.GetPixels()->GetData(), serial.GetPixels()->GetByteSize()) == 0 ;
+		failed += same ? 0 : 1 ;
+		std::printf("tiles threads=%u  %8.2f ms/frame  speedup %.2fx%s\n", threads, ms, serial_ms / ms, same ? "" : "  MISMATCH") ;
+	}
+
+	return failed ? 1 : 0 ;
+}
\ No newline at end of file
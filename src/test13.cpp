@@ -0,0 +1,106 @@
+// benchmark kontensi antrian event : 1 - 16 producer mendorong ke satu consumer,
+// MpscRing (policy Spin) dibandingkan mutex + std::deque. urutan per producer diperiksa.
+// angka kontensi baru berarti di mesin dengan core sebanyak producer-nya.
+// argumen opsional : jumlah item total per putaran (default 2000000)
+#include "mpscring.hpp"
+
+using namespace zketch ;
+
+// seukuran Event (tipe, handle, data, timestamp)
+struct Item {
+	uint32_t producer_ ;
+	uint32_t seq_ ;
+	uint64_t payload_[3] ;
+} ;
+
+static constexpr size_t RingCapacity = 4096 ;
+
+class MutexQueue {
+private :
+	std::mutex mutex_ ;
+	std::deque<Item> items_ ;
+
+public :
+	void Push(const Item& item) {
+		std::lock_guard<std::mutex> lock(mutex_) ;
+		items_.push_back(item) ;
+	}
+
+	size_t TryPopBulk(Item* out, size_t max) {
+		std::lock_guard<std::mutex> lock(mutex_) ;
+		size_t n = std::min(max, items_.size()) ;
+		std::copy_n(items_.begin(), n, out) ;
+		items_.erase(items_.begin(), items_.begin() + n) ;
+		return n ;
+	}
+} ;
+
+// return item per detik, 0 bila urutan per producer rusak
+template <typename Queue>
+static double Run(Queue& queue, uint32_t producers, uint32_t total) {
+	uint32_t per = total / producers ;
+	std::atomic<bool> go {false} ;
+	std::vector<std::thread> threads ;
+	threads.reserve(producers) ;
+
+	for (uint32_t p = 0; p < producers; ++p) {
+		threads.emplace_back([&queue, &go, p, per] {
+			while (!go.load(std::memory_order_acquire)) {
+				std::this_thread::yield() ;
+			}
+			for (uint32_t i = 0; i < per; ++i) {
+				queue.Push(Item{p, i, {i, p, 0}}) ;
+			}
+		}) ;
+	}
+
+	std::vector<uint32_t> next(producers, 0) ;
+	std::array<Item, 256> batch ;
+	bool ordered = true ;
+	uint64_t received = 0 ;
+	uint64_t expected = static_cast<uint64_t>(per) * producers ;
+
+	auto t0 = std::chrono::steady_clock::now() ;
+	go.store(true, std::memory_order_release) ;
+	while (received < expected) {
+		size_t n = queue.TryPopBulk(batch.data(), batch.size()) ;
+		if (n == 0) {
+			std::this_thread::yield() ;
+			continue ;
+		}
+		for (size_t i = 0; i < n; ++i) {
+			ordered = ordered && batch[i].seq_ == next[batch[i].producer_] ;
+			next[batch[i].producer_] = batch[i].seq_ + 1 ;
+		}
+		received += n ;
+	}
+	double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count() ;
+
+	for (auto& t : threads) {
+		t.join() ;
+	}
+	return ordered ? static_cast<double>(received) / sec : 0.0 ;
+}
+
+int main(int argc, char** argv) {
+	uint32_t total = argc > 1 ? static_cast<uint32_t>(std::max(16, std::atoi(argv[1]))) : 2000000u ;
+
+	std::printf("hardware threads : %u\n", std::thread::hardware_concurrency()) ;
+	std::printf("%u items, ring capacity %zu\n", total, RingCapacity) ;
+	std::printf("producers   MpscRing      mutex deque\n") ;
+
+	int failed = 0 ;
+	for (uint32_t producers : {1u, 2u, 4u, 8u, 16u}) {
+		MpscRing<Item, RingCapacity> ring ;
+		ring.SetOverflowPolicy(OverflowPolicy::Spin) ;
+		double lockfree = Run(ring, producers, total) ;
+
+		MutexQueue locked ;
+		double mutex = Run(locked, producers, total) ;
+
+		failed += (lockfree == 0.0 || mutex == 0.0) ? 1 : 0 ;
+		std::printf("%9u  %7.2f M/s  %9.2f M/s%s\n", producers, lockfree / 1.0e6, mutex / 1.0e6, (lockfree == 0.0 || mutex == 0.0) ? "  ORDER MISMATCH" : "") ;
+	}
+
+	return failed ? 1 : 0 ;
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+// pemeriksaan headless untuk WaitEvent di luar Win32 (condition variable WakeSignal) :
+// timeout, PostEvent dari thread lain, Wake tanpa event dan deadline ScheduleWake.
+// return 0 bila semua lolos.
+#include "event.hpp"
+
+using namespace zketch ;
+using Clock = std::chrono::steady_clock ;
+using namespace std::chrono_literals ;
+
+static int failed = 0 ;
+
+static void Check(bool ok, const char* what) {
+	if (!ok) {
+		logger::error("FAIL - ", what) ;
+		++failed ;
+	}
+}
+
+static void CheckTimeout() {
+	Event e ;
+	auto t0 = Clock::now() ;
+	Check(!WaitEvent(e, 30), "timeout : no event returns false") ;
+	Check(Clock::now() - t0 >= 29ms, "timeout : slept until the timeout") ;
+}
+
+static void CheckPostEvent() {
+	Event e ;
+	std::thread producer([] {
+		std::this_thread::sleep_for(20ms) ;
+		EventSystem::PostEvent(Event::CreateKeyEvent(nullptr, KeyState::Down, 65)) ;
+	}) ;
+
+	auto t0 = Clock::now() ;
+	bool got = WaitEvent(e, 5000) ;
+	auto waited = Clock::now() - t0 ;
+	producer.join() ;
+
+	Check(got && e.IsKeyEvent() && e.GetKeyCode() == 65, "post : posted event received") ;
+	Check(waited < 2s, "post : woken by PostEvent, not by the timeout") ;
+
+	// ditunggu tanpa batas waktu juga harus bangun
+	std::thread late([] {
+		std::this_thread::sleep_for(10ms) ;
+		EventSystem::PostEvent(Event::CreateKeyEvent(nullptr, KeyState::Up, 66)) ;
+	}) ;
+	Check(PollEvent(e, WaitMode::Block) && e.GetKeyCode() == 66, "post : WaitMode::Block wakes on PostEvent") ;
+	late.join() ;
+}
+
+static void CheckWakeWithoutEvent() {
+	Event e ;
+	std::thread waker([] {
+		std::this_thread::sleep_for(10ms) ;
+		EventSystem::Wake() ;
+	}) ;
+
+	// Wake tanpa event tidak mengakhiri WaitEvent, hanya memeriksa ulang antrian
+	auto t0 = Clock::now() ;
+	Check(!WaitEvent(e, 60), "wake : no event still times out") ;
+	Check(Clock::now() - t0 >= 59ms, "wake : spurious wake does not cut the timeout short") ;
+	waker.join() ;
+}
+
+static void CheckScheduledWake() {
+	Event e ;
+	auto t0 = Clock::now() ;
+	EventSystem::ScheduleWake(t0 + 25ms) ;
+	Check(!WaitEvent(e), "schedule : infinite wait returns at the scheduled deadline") ;
+	Check(Clock::now() - t0 >= 24ms && Clock::now() - t0 < 2s, "schedule : woke near the deadline") ;
+	Check(EventSystem::GetScheduledWake() == Clock::time_point::max(), "schedule : deadline cleared once reached") ;
+}
+
+int main() {
+	EventSystem::Init() ;
+	CheckTimeout() ;
+	CheckPostEvent() ;
+	CheckWakeWithoutEvent() ;
+	CheckScheduledWake() ;
+
+	if (failed) {
+		logger::error(failed, " check(s) failed") ;
+		return 1 ;
+	}
+
+	logger::info("wait checks passed") ;
+	return 0 ;
+}
\ No newline at end of file
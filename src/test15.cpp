@@ -0,0 +1,133 @@
+// pemeriksaan headless untuk present sebagian : SelectPresentRects, PresentRegion ke
+// MemoryPresentTarget, dan damage yang dipertahankan bila present gagal.
+// return 0 bila semua lolos.
+#include "renderer.hpp"
+#include "compositor.hpp"
+
+using namespace zketch ;
+
+static int failed = 0 ;
+
+static void Check(bool ok, const char* what) {
+	if (!ok) {
+		logger::error("FAIL - ", what) ;
+		++failed ;
+	}
+}
+
+// target yang selalu gagal di BeginPresent, seperti GetDC yang gagal
+struct FailingTarget {
+	uint32_t begins_ = 0 ;
+
+	bool BeginPresent(const Canvas&) noexcept { ++begins_ ; return false ; }
+	bool CopyRect(const Canvas&, const Rect&) noexcept { return true ; }
+	void EndPresent() noexcept {}
+} ;
+
+static bool SamePixels(const Canvas& canvas, const PixelBuffer& target) {
+	const PixelBuffer* src = canvas.GetPixels() ;
+	if (!src || target.GetSize() != src->GetSize()) {
+		return false ;
+	}
+	for (uint32_t y = 0; y < src->GetSize().y; ++y) {
+		if (std::memcmp(src->GetRow(y), target.GetRow(y), src->GetSize().x * sizeof(uint32_t)) != 0) {
+			return false ;
+		}
+	}
+	return true ;
+}
+
+static void CheckSelect() {
+	std::vector<Rect> out ;
+	DamageRegion region ;
+	const Size size {100, 100} ;
+
+	Check(!SelectPresentRects(region, size, 0.5f, out) && out.empty(), "select : empty damage copies nothing") ;
+
+	region.Add({10, 10, 20, 20}) ;
+	region.Add({90, 90, 30, 30}) ;
+	Check(!SelectPresentRects(region, size, 0.5f, out), "select : small damage stays partial") ;
+	Check(out.size() == 2, "select : one rect per damaged area") ;
+
+	bool clipped = true ;
+	for (const Rect& r : out) {
+		clipped = clipped && r.x >= 0 && r.y >= 0 && r.x + static_cast<int32_t>(r.w) <= 100 && r.y + static_cast<int32_t>(r.h) <= 100 ;
+	}
+	Check(clipped, "select : rects clipped to the surface") ;
+
+	region.Add({0, 0, 100, 60}) ;
+	Check(SelectPresentRects(region, size, 0.5f, out) && out.size() == 1 && out[0].w == 100 && out[0].h == 100, "select : coverage over threshold falls back to a full blit") ;
+
+	Check(!SelectPresentRects(region, Size{0, 0}, 0.5f, out) && out.empty(), "select : empty surface copies nothing") ;
+}
+
+static void CheckMemoryTarget() {
+	Canvas canvas ;
+	if (!canvas.Create({64, 48})) {
+		Check(false, "memory : canvas creation") ;
+		return ;
+	}
+
+	MemoryPresentTarget target ;
+	std::vector<Rect> scratch ;
+
+	Renderer r ;
+	r.Begin(canvas) ;
+	r.Clear(White) ;
+	r.End() ;
+
+	PresentStats full = PresentRegion(canvas, canvas.GetDamage(), target, DefaultPresentThreshold, scratch) ;
+	Check(full.presented_ && full.full_ && full.bytes_copied_ == 64u * 48u * 4u, "memory : first present copies the whole frame") ;
+	Check(SamePixels(canvas, target.GetPixels()), "memory : full present matches the canvas") ;
+	canvas.MarkValidate() ;
+
+	r.Begin(canvas) ;
+	r.FillRect({8, 4, 10, 6}, Red) ;
+	r.End() ;
+
+	PresentStats part = PresentRegion(canvas, canvas.GetDamage(), target, DefaultPresentThreshold, scratch) ;
+	Check(part.presented_ && !part.full_ && part.rect_count_ >= 1, "memory : small change is presented partially") ;
+	Check(part.bytes_copied_ >= 10u * 6u * 4u && part.bytes_copied_ < 64u * 48u * 4u, "memory : partial present copies less than a frame") ;
+	Check(SamePixels(canvas, target.GetPixels()), "memory : partial present matches the canvas") ;
+}
+
+static void CheckFailedPresentKeepsDamage() {
+	Canvas layer ;
+	Compositor compositor ;
+	if (!layer.Create({32, 32}) || !compositor.Create({64, 64})) {
+		Check(false, "failure : setup") ;
+		return ;
+	}
+
+	Renderer r ;
+	r.Begin(layer) ;
+	r.Clear(Blue) ;
+	r.End() ;
+	compositor.AddLayer(&layer, {8, 8}) ;
+	compositor.Compose() ;
+	Check(!compositor.GetOutput().GetDamage().IsEmpty(), "failure : compose leaves output damage") ;
+
+	FailingTarget failing ;
+	PresentStats stats = compositor.Present(failing) ;
+	Check(failing.begins_ == 1 && !stats.presented_ && stats.bytes_copied_ == 0, "failure : failed present reports nothing copied") ;
+	Check(!compositor.GetOutput().GetDamage().IsEmpty(), "failure : damage kept after a failed present") ;
+
+	MemoryPresentTarget target ;
+	stats = compositor.Present(target) ;
+	Check(stats.presented_ && compositor.GetOutput().GetDamage().IsEmpty(), "failure : damage cleared once a present succeeds") ;
+	Check(SamePixels(compositor.GetOutput(), target.GetPixels()), "failure : retried present matches the output") ;
+}
+
+int main() {
+	CheckSelect() ;
+	CheckMemoryTarget() ;
+	CheckFailedPresentKeepsDamage() ;
+
+	if (failed) {
+		logger::error(failed, " check(s) failed") ;
+		return 1 ;
+	}
+
+	logger::info("present checks passed") ;
+	return 0 ;
+}
\ No newline at end of file
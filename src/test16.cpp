@@ -0,0 +1,135 @@
+// pemeriksaan headless untuk penggabungan event mouse (EventSystem::SetCoalescing) pada
+// aliran event sintetis. return 0 bila semua lolos.
+#include "event.hpp"
+
+using namespace zketch ;
+
+static int failed = 0 ;
+
+static void Check(bool ok, const char* what) {
+	if (!ok) {
+		logger::error("FAIL - ", what) ;
+		++failed ;
+	}
+}
+
+static HWND WindowA() noexcept { return reinterpret_cast<HWND>(static_cast<uintptr_t>(0x10)) ; }
+static HWND WindowB() noexcept { return reinterpret_cast<HWND>(static_cast<uintptr_t>(0x20)) ; }
+
+static Event Move(HWND hwnd, int32_t x, int32_t y) {
+	return Event::CreateMouseEvent(hwnd, MouseButton::None, MouseState::None, {x, y}) ;
+}
+
+static Event Wheel(HWND hwnd, int32_t x, int32_t y, int32_t delta) {
+	return Event::CreateMouseEvent(hwnd, MouseButton::None, MouseState::Wheel, {x, y}, delta) ;
+}
+
+static void Reset(Coalesce mode) {
+	EventSystem::Clear() ;
+	EventSystem::SetCoalescing(mode) ;
+}
+
+static void CheckMoves() {
+	Reset(Coalesce::MouseMove) ;
+	Event first = Move(WindowA(), 1, 1) ;
+	EventSystem::PushEvent(first) ;
+	EventSystem::PushEvent(Move(WindowA(), 2, 3)) ;
+	EventSystem::PushEvent(Move(WindowA(), 5, 8)) ;
+
+	Event e ;
+	Check(EventSystem::PollEvent(e), "move : merged event returned") ;
+	Check(e.GetMousePosition().x == 5 && e.GetMousePosition().y == 8, "move : merged event has the latest position") ;
+	Check(e.GetTimeStamp() == first.GetTimeStamp(), "move : merged event keeps the first timestamp") ;
+
+	const auto& samples = EventSystem::GetCoalescedSamples() ;
+	Check(samples.size() == 3 && samples[0].GetMousePosition().x == 1 && samples[1].GetMousePosition().x == 2 && samples[2].GetMousePosition().x == 5, "move : all samples kept in order") ;
+	Check(!EventSystem::PollEvent(e), "move : three moves become one event") ;
+	Check(EventSystem::GetCoalescedSamples().empty(), "move : samples cleared by the next poll") ;
+}
+
+static void CheckWindowsDoNotMerge() {
+	Reset(Coalesce::All) ;
+	EventSystem::PushEvent(Move(WindowA(), 1, 1)) ;
+	EventSystem::PushEvent(Move(WindowB(), 2, 2)) ;
+	EventSystem::PushEvent(Move(WindowA(), 3, 3)) ;
+
+	Event e ;
+	int count = 0 ;
+	while (EventSystem::PollEvent(e)) {
+		++count ;
+	}
+	Check(count == 3, "window : moves on different windows are not merged") ;
+	Check(!EventSystem::CanCoalesce(Move(WindowA(), 0, 0), Move(WindowB(), 0, 0), Coalesce::All), "window : CanCoalesce rejects different windows") ;
+}
+
+static void CheckWheel() {
+	Reset(Coalesce::Wheel) ;
+	EventSystem::PushEvent(Wheel(WindowA(), 4, 4, 120)) ;
+	EventSystem::PushEvent(Wheel(WindowA(), 5, 5, 120)) ;
+	EventSystem::PushEvent(Wheel(WindowA(), 6, 6, -40)) ;
+
+	Event e ;
+	Check(EventSystem::PollEvent(e) && e.GetMouseWheelValue() == 200, "wheel : deltas summed") ;
+	Check(e.GetMousePosition().x == 6, "wheel : latest position kept") ;
+	Check(!EventSystem::PollEvent(e), "wheel : one event left") ;
+
+	// mode Wheel saja tidak menggabung move
+	Reset(Coalesce::Wheel) ;
+	EventSystem::PushEvent(Move(WindowA(), 1, 1)) ;
+	EventSystem::PushEvent(Move(WindowA(), 2, 2)) ;
+	Check(EventSystem::PollEvent(e) && e.GetMousePosition().x == 1, "wheel : moves untouched in Wheel mode") ;
+}
+
+static void CheckRunBreak() {
+	Reset(Coalesce::All) ;
+	EventSystem::PushEvent(Move(WindowA(), 1, 1)) ;
+	EventSystem::PushEvent(Move(WindowA(), 2, 2)) ;
+	EventSystem::PushEvent(Event::CreateMouseEvent(WindowA(), MouseButton::Left, MouseState::Down, {2, 2})) ;
+	EventSystem::PushEvent(Move(WindowA(), 3, 3)) ;
+	EventSystem::PushEvent(Event::CreateKeyEvent(WindowA(), KeyState::Down, 65)) ;
+	EventSystem::PushEvent(Move(WindowA(), 4, 4)) ;
+
+	Event e ;
+	Check(EventSystem::PollEvent(e) && e.GetMouseState() == MouseState::None && e.GetMousePosition().x == 2, "break : moves before the click merged") ;
+	Check(EventSystem::PollEvent(e) && e.GetMouseState() == MouseState::Down, "break : click kept in order") ;
+	Check(EventSystem::PollEvent(e) && e.GetMousePosition().x == 3, "break : move after the click not merged across it") ;
+	Check(EventSystem::PollEvent(e) && e.IsKeyEvent(), "break : key kept in order") ;
+	Check(EventSystem::PollEvent(e) && e.GetMousePosition().x == 4, "break : move after the key not merged across it") ;
+	Check(!EventSystem::PollEvent(e), "break : nothing left") ;
+
+	Reset(Coalesce::None) ;
+	EventSystem::PushEvent(Move(WindowA(), 1, 1)) ;
+	EventSystem::PushEvent(Move(WindowA(), 2, 2)) ;
+	Check(EventSystem::PollEvent(e) && e.GetMousePosition().x == 1 && EventSystem::PollEvent(e), "break : Coalesce::None passes every move") ;
+}
+
+static void CheckSampleBound() {
+	Reset(Coalesce::MouseMove) ;
+	const int count = static_cast<int>(EventSystem::MaxCoalescedSamples) + 100 ;
+	for (int i = 0; i < count; ++i) {
+		EventSystem::PushEvent(Move(WindowA(), i, i)) ;
+	}
+
+	Event e ;
+	Check(EventSystem::PollEvent(e) && e.GetMousePosition().x == count - 1, "bound : merged event still reaches the latest position") ;
+	Check(EventSystem::GetCoalescedSamples().size() == EventSystem::MaxCoalescedSamples, "bound : samples capped at MaxCoalescedSamples") ;
+	Check(EventSystem::GetCoalescedSamples().front().GetMousePosition().x == 0, "bound : oldest samples kept") ;
+	Check(!EventSystem::PollEvent(e), "bound : whole run merged") ;
+}
+
+int main() {
+	EventSystem::Init() ;
+	CheckMoves() ;
+	CheckWindowsDoNotMerge() ;
+	CheckWheel() ;
+	CheckRunBreak() ;
+	CheckSampleBound() ;
+
+	if (failed) {
+		logger::error(failed, " check(s) failed") ;
+		return 1 ;
+	}
+
+	logger::info("coalescing checks passed") ;
+	return 0 ;
+}
\ No newline at end of file
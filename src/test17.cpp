@@ -0,0 +1,82 @@
+// benchmark headless hit test : widget 40x20 acak, query titik acak dengan scan linear
+// (seperti loop OnHover lama, dari atas ke bawah) dibandingkan SpatialGrid, pada 100 /
+// 1000 / 10000 widget. hasil tiap query dibandingkan, lalu biaya Update (SetPosition).
+// argumen opsional : jumlah query (default 100000)
+#include "spatialindex.hpp"
+
+using namespace zketch ;
+
+static uint32_t seed = 7 ;
+
+static float Random(float max) noexcept {
+	seed = seed * 1103515245u + 12345u ;
+	return static_cast<float>((seed >> 8) % 65536) / 65536.0f * max ;
+}
+
+// entry terakhir yang berisi p, sama dengan urutan z SpatialGrid
+static int32_t LinearQuery(const std::vector<RectF>& bounds, const PointF& p) noexcept {
+	for (size_t i = bounds.size(); i-- > 0;) {
+		if (bounds[i].Contain(p)) {
+			return static_cast<int32_t>(i) ;
+		}
+	}
+	return -1 ;
+}
+
+int main(int argc, char** argv) {
+	int queries = argc > 1 ? std::max(1, std::atoi(argv[1])) : 100000 ;
+	const float width = 1920.0f ;
+	const float height = 1080.0f ;
+
+	std::printf("%d queries, widgets 40x20 in %.0fx%.0f\n", queries, width, height) ;
+	std::printf("widgets    linear/query   grid/query   grid update\n") ;
+
+	int failed = 0 ;
+	for (size_t n : {size_t(100), size_t(1000), size_t(10000)}) {
+		std::vector<RectF> bounds(n) ;
+		std::vector<SpatialId> ids(n) ;
+		SpatialGrid grid ;
+		for (size_t i = 0; i < n; ++i) {
+			bounds[i] = RectF{Random(width - 40.0f), Random(height - 20.0f), 40.0f, 20.0f} ;
+			ids[i] = grid.Insert(bounds[i], reinterpret_cast<void*>(i + 1)) ;
+		}
+
+		std::vector<PointF> points(queries) ;
+		for (PointF& p : points) {
+			p = {Random(width), Random(height)} ;
+		}
+
+		int64_t sink = 0 ;
+		auto t0 = std::chrono::steady_clock::now() ;
+		for (const PointF& p : points) {
+			sink += LinearQuery(bounds, p) ;
+		}
+		auto t1 = std::chrono::steady_clock::now() ;
+		for (const PointF& p : points) {
+			sink -= static_cast<int64_t>(reinterpret_cast<uintptr_t>(grid.QueryUser(p))) - 1 ;
+		}
+		auto t2 = std::chrono::steady_clock::now() ;
+
+		// hasil harus sama persis dengan scan linear
+		bool same = sink == 0 ;
+		for (size_t i = 0; i < points.size() && same; i += 97) {
+			same = LinearQuery(bounds, points[i]) + 1 == static_cast<int64_t>(reinterpret_cast<uintptr_t>(grid.QueryUser(points[i]))) ;
+		}
+		failed += same ? 0 : 1 ;
+
+		// widget digeser sedikit, seperti drag
+		auto t3 = std::chrono::steady_clock::now() ;
+		for (size_t i = 0; i < n; ++i) {
+			bounds[i].x = std::min(bounds[i].x + 3.0f, width - 40.0f) ;
+			grid.Update(ids[i], bounds[i]) ;
+		}
+		auto t4 = std::chrono::steady_clock::now() ;
+
+		double linear_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / queries ;
+		double grid_ns = std::chrono::duration<double, std::nano>(t2 - t1).count() / queries ;
+		double update_ns = std::chrono::duration<double, std::nano>(t4 - t3).count() / static_cast<double>(n) ;
+		std::printf("%7zu   %10.1f ns  %9.1f ns  %9.1f ns%s\n", n, linear_ns, grid_ns, update_ns, same ? "" : "  MISMATCH") ;
+	}
+
+	return failed ? 1 : 0 ;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+// benchmark headless biaya salin frame ke MemoryPresentTarget : blit penuh dibandingkan
+// hanya rect yang rusak (16 widget 120x32, lalu satu panel seperempat layar), pada
+// beberapa ukuran window. argumen opsional : jumlah present per kasus (default 50)
+#include "present.hpp"
+
+using namespace zketch ;
+
+struct Result {
+	double ms_ ;
+	uint64_t bytes_ ;
+	uint32_t rects_ ;
+	bool full_ ;
+} ;
+
+static Result Measure(const Canvas& canvas, const DamageRegion& damage, float threshold, int frames) {
+	MemoryPresentTarget target ;
+	std::vector<Rect> scratch ;
+	PresentStats stats = PresentRegion(canvas, damage, target, threshold, scratch) ; // pemanasan
+
+	auto t0 = std::chrono::steady_clock::now() ;
+	for (int i = 0; i < frames; ++i) {
+		stats = PresentRegion(canvas, damage, target, threshold, scratch) ;
+	}
+	double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count() / frames ;
+	return {ms, stats.bytes_copied_, stats.rect_count_, stats.full_} ;
+}
+
+static void Report(const char* name, const Result& r) {
+	double gbps = r.ms_ > 0.0 ? static_cast<double>(r.bytes_) / (r.ms_ * 1.0e6) : 0.0 ;
+	std::printf("  %-14s %3u rect%s %9.3f ms  %8.2f MB  %6.2f GB/s\n", name, r.rects_, r.full_ ? " (full)" : "       ", r.ms_, static_cast<double>(r.bytes_) / 1.0e6, gbps) ;
+}
+
+int main(int argc, char** argv) {
+	int frames = argc > 1 ? std::max(1, std::atoi(argv[1])) : 50 ;
+	const Size sizes[] = {{640, 480}, {1280, 720}, {1920, 1080}, {3840, 2160}} ;
+
+	std::printf("%d presents per case\n", frames) ;
+	for (const Size& size : sizes) {
+		Canvas canvas ;
+		if (!canvas.Create(size)) {
+			logger::error("test18 - canvas creation failed") ;
+			return 1 ;
+		}
+		std::memset(canvas.GetPixels()->GetData(), 0x7F, canvas.GetPixels()->GetByteSize()) ;
+
+		DamageRegion full ;
+		full.Add({0, 0, size.x, size.y}) ;
+
+		// widget kecil tersebar (hover, caret) : di bawah DamageRegion::DefaultCapacity
+		DamageRegion widgets ;
+		for (uint32_t i = 0; i < 16; ++i) {
+			widgets.Add({static_cast<int32_t>((i % 4) * (size.x / 4) + 8), static_cast<int32_t>((i / 4) * (size.y / 4) + 8), 120, 32}) ;
+		}
+
+		DamageRegion panel ;
+		panel.Add({0, 0, size.x / 2, size.y / 2}) ;
+
+		std::printf("%ux%u\n", size.x, size.y) ;
+		Report("full frame", Measure(canvas, full, DefaultPresentThreshold, frames)) ;
+		Report("16 widgets", Measure(canvas, widgets, DefaultPresentThreshold, frames)) ;
+		Report("quarter panel", Measure(canvas, panel, DefaultPresentThreshold, frames)) ;
+	}
+
+	return 0 ;
+}
\ No newline at end of file
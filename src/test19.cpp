@@ -0,0 +1,151 @@
+// pemeriksaan headless untuk DisplayList : format command, replay yang identik dengan
+// gambar langsung, key, dan ChromeCache Button yang tidak merekam ulang saat hover.
+// return 0 bila semua lolos.
+#include "zketch.hpp"
+#include "button.hpp"
+
+using namespace zketch ;
+
+static int failed = 0 ;
+
+static void Check(bool ok, const char* what) {
+	if (!ok) {
+		logger::error("FAIL - ", what) ;
+		++failed ;
+	}
+}
+
+static bool SamePixels(const Canvas& a, const Canvas& b) {
+	const PixelBuffer* pa = a.GetPixels() ;
+	const PixelBuffer* pb = b.GetPixels() ;
+	if (!pa || !pb || pa->GetSize() != pb->GetSize()) {
+		return false ;
+	}
+	for (uint32_t y = 0; y < pa->GetSize().y; ++y) {
+		if (std::memcmp(pa->GetRow(y), pb->GetRow(y), pa->GetSize().x * sizeof(uint32_t)) != 0) {
+			return false ;
+		}
+	}
+	return true ;
+}
+
+static void Draw(Renderer& r) {
+	r.Clear(White) ;
+	r.FillRect({4, 4, 20, 10}, Red) ;
+	r.FillRectRounded({10, 20, 40, 24}, Blue, 6.0f) ;
+	r.DrawRectRounded({10, 20, 40, 24}, Black, 6.0f, 2.0f) ;
+	r.DrawLine(Point{2, 60}, Point{60, 30}, Green, 1.5f) ;
+	r.FillPolygon({{40, 4}, {60, 20}, {44, 24}}, Color(rgba8(200, 100, 50, 180))) ;
+}
+
+static void CheckFormat() {
+	DisplayList list ;
+	uint64_t key = DisplayList::MakeKey(64.0f, 64.0f) ;
+
+	Renderer recorder ;
+	Check(recorder.Begin(list, key), "format : recording starts") ;
+	Check(list.IsRecording(), "format : list is recording") ;
+	Draw(recorder) ;
+	recorder.End() ;
+
+	Check(!list.IsRecording() && list.IsValid(key) && !list.IsValid(key + 1), "format : list valid only for its key") ;
+	Check(list.GetCommandCount() == 6, "format : one command per draw call") ;
+	Check(list.GetByteSize() % 8 == 0, "format : commands padded to 8 bytes") ;
+
+	std::vector<DrawOp> ops ;
+	RectF fill {} ;
+	list.ForEach([&](DrawOp op, const std::byte* data) {
+		ops.push_back(op) ;
+		if (op == DrawOp::FillRect) {
+			fill = DisplayList::Read<DisplayList::ShapeCmd>(data).rect_ ;
+		}
+	}) ;
+	const std::vector<DrawOp> expected {DrawOp::Clear, DrawOp::FillRect, DrawOp::FillRectRounded, DrawOp::DrawRectRounded, DrawOp::DrawLine, DrawOp::FillPolygon} ;
+	Check(ops == expected, "format : commands kept in order") ;
+	Check(fill.x == 4.0f && fill.y == 4.0f && fill.w == 20.0f && fill.h == 10.0f, "format : payload read back") ;
+
+	// perekaman ulang memakai kapasitas yang sama
+	size_t bytes = list.GetByteSize() ;
+	recorder.Begin(list, key) ;
+	Draw(recorder) ;
+	recorder.End() ;
+	Check(list.GetByteSize() == bytes && list.GetCommandCount() == 6, "format : re-record gives the same buffer") ;
+
+	list.Invalidate() ;
+	Check(!list.IsValid(key), "format : Invalidate drops the list") ;
+	list.Reset() ;
+	Check(list.IsEmpty() && list.GetByteSize() == 0, "format : Reset empties the list") ;
+}
+
+static void CheckReplay() {
+	Canvas direct ;
+	Canvas replayed ;
+	if (!direct.Create({64, 64}) || !replayed.Create({64, 64})) {
+		Check(false, "replay : canvas creation") ;
+		return ;
+	}
+
+	Renderer r ;
+	r.Begin(direct) ;
+	Draw(r) ;
+	r.End() ;
+
+	DisplayList list ;
+	r.Begin(list) ;
+	Draw(r) ;
+	r.End() ;
+
+	r.Begin(replayed) ;
+	r.Replay(list) ;
+	r.End() ;
+	Check(SamePixels(direct, replayed), "replay : identical to drawing directly") ;
+}
+
+static void CheckKey() {
+	Check(DisplayList::MakeKey(1.0f, 2.0f) == DisplayList::MakeKey(1.0f, 2.0f), "key : deterministic") ;
+	Check(DisplayList::MakeKey(1.0f, 2.0f) != DisplayList::MakeKey(2.0f, 1.0f), "key : order matters") ;
+	Check(DisplayList::MakeKey(-0.0f) == DisplayList::MakeKey(0.0f), "key : -0.0f equals +0.0f") ;
+	Check(DisplayList::MakeKey(true, 3u) != DisplayList::MakeKey(false, 3u), "key : bool input mixed in") ;
+}
+
+static void CheckButtonChrome() {
+	Button button(RectF{0, 0, 80, 24}, Font()) ;
+	button.InvokeUpdate() ;
+	const auto& cache = button.GetChromeCache() ;
+	Check(cache.GetRecordCount() == 1 && cache.GetRasterizeCount() == 1, "chrome : normal state built once") ;
+
+	// hover bolak-balik : tiap state direkam dan dirasterisasi sekali saja
+	for (int i = 0; i < 4; ++i) {
+		button.OnHover({10, 10}) ;
+		button.InvokeUpdate() ;
+		button.OnHover({500, 500}) ;
+		button.InvokeUpdate() ;
+	}
+	Check(cache.GetRecordCount() == 2 && cache.GetRasterizeCount() == 2, "chrome : hover toggles reuse both states") ;
+
+	button.OnPress({10, 10}) ;
+	button.InvokeUpdate() ;
+	button.OnRelease({500, 500}) ;
+	button.InvokeUpdate() ;
+	Check(cache.GetRecordCount() == 3 && cache.GetRasterizeCount() == 3, "chrome : press state built once") ;
+
+	// tanpa label, canvas button sama dengan chrome state normal
+	const Canvas* chrome = button.GetChrome() ;
+	Check(chrome && SamePixels(*chrome, *button.GetCanvas()), "chrome : redraw copies the cached pixels") ;
+	Check(cache.GetRecordCount() == 3, "chrome : GetChrome on a cached state records nothing") ;
+}
+
+int main() {
+	CheckFormat() ;
+	CheckReplay() ;
+	CheckKey() ;
+	CheckButtonChrome() ;
+
+	if (failed) {
+		logger::error(failed, " check(s) failed") ;
+		return 1 ;
+	}
+
+	logger::info("display list checks passed") ;
+	return 0 ;
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+// pemeriksaan headless untuk koordinat ekstrem di Renderer / Rasterizer : rect NaN / inf
+// ditolak tanpa menyentuh canvas, rect raksasa dijepit ke clip sebelum dikonversi ke int.
+// sebaiknya juga dijalankan dengan -fsanitize=undefined. return 0 bila semua lolos.
+#include "renderer.hpp"
+
+using namespace zketch ;
+
+static int failed = 0 ;
+
+static void Check(bool ok, const char* what) {
+	if (!ok) {
+		logger::error("FAIL - ", what) ;
+		++failed ;
+	}
+}
+
+static uint32_t CountPixels(const Canvas& canvas, uint32_t px) {
+	const PixelBuffer* pixels = canvas.GetPixels() ;
+	uint32_t n = 0 ;
+	for (uint32_t y = 0; y < pixels->GetSize().y; ++y) {
+		for (uint32_t x = 0; x < pixels->GetSize().x; ++x) {
+			n += pixels->GetRow(y)[x] == px ? 1 : 0 ;
+		}
+	}
+	return n ;
+}
+
+static void CheckNonFinite(Canvas& canvas) {
+	const float nan = std::numeric_limits<float>::quiet_NaN() ;
+	const float inf = std::numeric_limits<float>::infinity() ;
+
+	Renderer r ;
+	r.Begin(canvas) ;
+	r.Clear(White) ;
+	r.End() ;
+	canvas.MarkValidate() ;
+
+	r.Begin(canvas) ;
+	r.FillEllipse({nan, 0, 10, 10}, Red) ;
+	r.FillEllipse({0, 0, inf, 10}, Red) ;
+	r.DrawEllipse({0, nan, 10, 10}, Red) ;
+	r.DrawRect({0, 0, 10, -inf}, Red) ;
+	r.FillRectRounded({nan, nan, nan, nan}, Red, 2.0f) ;
+	r.DrawRectRounded({0, 0, inf, inf}, Red, 2.0f) ;
+	r.FillPolygon({{0, 0}, {nan, 10}, {10, 10}}, Red) ;
+	r.DrawPolygon({{0, 0}, {10, inf}, {10, 10}}, Red) ;
+	r.End() ;
+
+	Check(CountPixels(canvas, ToPixel(White)) == 64u * 64u, "non-finite : canvas untouched") ;
+	Check(canvas.GetDamage().IsEmpty(), "non-finite : no damage recorded") ;
+}
+
+static void CheckHuge(Canvas& canvas) {
+	Renderer r ;
+	r.Begin(canvas) ;
+	r.Clear(White) ;
+	r.FillRect({std::numeric_limits<int32_t>::min(), -5, std::numeric_limits<uint32_t>::max(), 0xFFFFFFFFu}, Red) ;
+	r.End() ;
+	Check(CountPixels(canvas, ToPixel(Red)) == 64u * 64u, "huge : int rect clipped to the canvas") ;
+
+	r.Begin(canvas) ;
+	r.Clear(White) ;
+	r.FillEllipse({-1.0e30f, -1.0e30f, 2.0e30f, 2.0e30f}, Blue) ;
+	r.End() ;
+	Check(CountPixels(canvas, ToPixel(Blue)) == 64u * 64u, "huge : ellipse covering the canvas fills it") ;
+
+	r.Begin(canvas) ;
+	r.Clear(White) ;
+	r.FillRectRounded({1.0e20f, 1.0e20f, 5.0f, 5.0f}, Blue, 2.0f) ;
+	r.DrawRect({-1.0e20f, 10.0f, 1.0e20f + 20.0f, 4.0f}, Green, 2.0f) ;
+	r.End() ;
+	Check(CountPixels(canvas, ToPixel(Blue)) == 0, "huge : far off-canvas shape draws nothing") ;
+
+	r.Begin(canvas) ;
+	r.Clear(White) ;
+	r.FillEllipse({-8.0f, -8.0f, 16.0f, 16.0f}, Red) ;
+	r.End() ;
+	uint32_t quarter = CountPixels(canvas, ToPixel(Red)) ;
+	Check(quarter > 40 && quarter < 64, "edge : ellipse clipped at the canvas corner") ;
+}
+
+int main() {
+	Canvas canvas ;
+	if (!canvas.Create({64, 64})) {
+		logger::error("test20 - canvas creation failed") ;
+		return 1 ;
+	}
+
+	CheckNonFinite(canvas) ;
+	CheckHuge(canvas) ;
+
+	if (failed) {
+		logger::error(failed, " check(s) failed") ;
+		return 1 ;
+	}
+
+	logger::info("coordinate checks passed") ;
+	return 0 ;
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+// pemeriksaan dan benchmark headless untuk LruCache : urutan eviction, SetCapacity yang
+// mengecil, counter hit / miss / eviction, Find, lalu biaya lookup untuk beberapa
+// rasio hit. argumen opsional : jumlah lookup per kasus (default 1000000)
+#include "lrucache.hpp"
+
+using namespace zketch ;
+
+static int failed = 0 ;
+
+static void Check(bool ok, const char* what) {
+	if (!ok) {
+		logger::error("FAIL - ", what) ;
+		++failed ;
+	}
+}
+
+static std::vector<int> Keys(const LruCache<int, int>& cache) {
+	std::vector<int> keys ;
+	for (const auto& entry : cache.GetEntries()) {
+		keys.push_back(entry.first) ;
+	}
+	return keys ;
+}
+
+static void CheckEviction() {
+	LruCache<int, int> cache(3) ;
+	int made = 0 ;
+	auto make = [&made] { return ++made ; } ;
+
+	cache.GetOrCreate(1, make) ;
+	cache.GetOrCreate(2, make) ;
+	cache.GetOrCreate(3, make) ;
+	Check(Keys(cache) == std::vector<int>{3, 2, 1}, "eviction : most recent first") ;
+
+	// 1 dipakai lagi, jadi 2 yang terlama dan tergusur oleh 4
+	Check(cache.GetOrCreate(1, make) == 1 && made == 3, "eviction : hit does not call make") ;
+	cache.GetOrCreate(4, make) ;
+	Check(Keys(cache) == std::vector<int>{4, 1, 3}, "eviction : least recently used evicted") ;
+	Check(!cache.Contains(2) && cache.Contains(3), "eviction : evicted key gone") ;
+
+	Check(cache.GetOrCreate(2, make) == 5, "eviction : evicted key rebuilt on miss") ;
+	Check(Keys(cache) == std::vector<int>{2, 4, 1}, "eviction : rebuilt key at the front") ;
+
+	// Find memajukan entry tanpa mengubah statistik
+	uint64_t hits = cache.GetHits() ;
+	Check(cache.Find(1) && *cache.Find(1) == 1 && !cache.Find(3), "find : present and absent keys") ;
+	Check(Keys(cache).front() == 1 && cache.GetHits() == hits, "find : moves to front without counting a hit") ;
+}
+
+static void CheckShrink() {
+	LruCache<int, int> cache(5) ;
+	for (int i = 0; i < 5; ++i) {
+		cache.GetOrCreate(i, [i] { return i * 10 ; }) ;
+	}
+	cache.ResetStats() ;
+
+	cache.SetCapacity(2) ;
+	Check(cache.GetCapacity() == 2 && cache.GetSize() == 2, "shrink : size trimmed to the new capacity") ;
+	Check(Keys(cache) == std::vector<int>{4, 3}, "shrink : most recent entries kept") ;
+	Check(cache.GetEvictions() == 3, "shrink : trimmed entries counted as evictions") ;
+	Check(!cache.Contains(0) && !cache.Contains(2), "shrink : trimmed keys unindexed") ;
+
+	cache.SetCapacity(0) ;
+	Check(cache.GetCapacity() == 1 && cache.GetSize() == 1, "shrink : capacity 0 treated as 1") ;
+
+	cache.SetCapacity(4) ;
+	cache.GetOrCreate(7, [] { return 70 ; }) ;
+	Check(cache.GetSize() == 2 && cache.GetEvictions() == 4, "shrink : growing again does not evict") ;
+}
+
+static void CheckCounters() {
+	LruCache<int, int> cache(2) ;
+	auto make = [] { return 0 ; } ;
+
+	cache.GetOrCreate(1, make) ; // miss
+	cache.GetOrCreate(1, make) ; // hit
+	cache.GetOrCreate(2, make) ; // miss
+	cache.GetOrCreate(3, make) ; // miss + evict 1
+	cache.GetOrCreate(2, make) ; // hit
+	Check(cache.GetHits() == 2 && cache.GetMisses() == 3 && cache.GetEvictions() == 1, "counters : hits, misses and evictions") ;
+
+	cache.ResetStats() ;
+	Check(cache.GetHits() == 0 && cache.GetMisses() == 0 && cache.GetEvictions() == 0 && cache.GetSize() == 2, "counters : ResetStats keeps entries") ;
+
+	cache.Clear() ;
+	Check(cache.GetSize() == 0 && !cache.Contains(2), "counters : Clear empties the cache") ;
+	cache.GetOrCreate(5, make) ;
+	Check(cache.GetSize() == 1 && cache.GetMisses() == 1, "counters : usable after Clear") ;
+}
+
+static volatile uint64_t sink ;
+
+// lookup dengan key acak dari universe ; hit rate ~ capacity / universe
+static void Bench(size_t capacity, uint32_t universe, int lookups) {
+	LruCache<uint32_t, uint64_t> cache(capacity) ;
+	std::vector<uint32_t> keys(lookups) ;
+	uint32_t seed = 17 ;
+	for (uint32_t& k : keys) {
+		seed = seed * 1103515245u + 12345u ;
+		k = (seed >> 8) % universe ;
+	}
+
+	uint64_t sum = 0 ;
+	auto t0 = std::chrono::steady_clock::now() ;
+	for (uint32_t k : keys) {
+		sum += cache.GetOrCreate(k, [k] { return static_cast<uint64_t>(k) * 3 ; }) ;
+	}
+	double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count() / lookups ;
+	sink = sum ;
+
+	double hit_rate = static_cast<double>(cache.GetHits()) / static_cast<double>(lookups) ;
+	std::printf("%9zu  %9u  %7.1f %%  %8.1f ns\n", capacity, universe, hit_rate * 100.0, ns) ;
+}
+
+int main(int argc, char** argv) {
+	int lookups = argc > 1 ? std::max(1, std::atoi(argv[1])) : 1000000 ;
+
+	CheckEviction() ;
+	CheckShrink() ;
+	CheckCounters() ;
+
+	std::printf("%d lookups per case\n", lookups) ;
+	std::printf(" capacity   universe   hit rate   per lookup\n") ;
+	Bench(256, 256, lookups) ;
+	Bench(256, 320, lookups) ;
+	Bench(256, 1024, lookups) ;
+	Bench(4096, 4096, lookups) ;
+	Bench(4096, 65536, lookups) ;
+
+	if (failed) {
+		logger::error(failed, " check(s) failed") ;
+		return 1 ;
+	}
+
+	logger::info("lru cache checks passed") ;
+	return 0 ;
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+// pemeriksaan headless untuk SurfacePool : pembulatan size class, pemakaian ulang block,
+// counter live / peak / cached, Trim, dan PixelBuffer yang memakai pool global.
+// return 0 bila semua lolos.
+#include "renderer.hpp"
+
+using namespace zketch ;
+
+static int failed = 0 ;
+
+static void Check(bool ok, const char* what) {
+	if (!ok) {
+		logger::error("FAIL - ", what) ;
+		++failed ;
+	}
+}
+
+static void CheckClasses() {
+	size_t bytes = 0 ;
+	Check(SurfacePool::ClassOf(1, &bytes) == 0 && bytes == SurfacePool::MinBytes, "class : tiny request rounds up to MinBytes") ;
+	Check(SurfacePool::ClassOf(SurfacePool::MinBytes, &bytes) == 0 && bytes == SurfacePool::MinBytes, "class : MinBytes is class 0") ;
+	Check(SurfacePool::ClassOf(4097, &bytes) == 1 && bytes == 5120, "class : 4097 -> 1.25 * 4096") ;
+	Check(SurfacePool::ClassOf(8192, &bytes) == 4 && bytes == 8192, "class : power of two is exact") ;
+	Check(SurfacePool::ClassOf(8193, &bytes) == 5 && bytes == 10240, "class : next octave starts at 1.25x") ;
+
+	// kapasitas cukup, boros paling banyak 25 %, index naik bersama kapasitas
+	bool fits = true ;
+	bool tight = true ;
+	bool monotonic = true ;
+	size_t last_index = 0 ;
+	size_t last_bytes = SurfacePool::MinBytes ;
+	for (size_t n = 1; n <= (size_t(1) << 22); n += 1 + n / 64) {
+		size_t index = SurfacePool::ClassOf(n, &bytes) ;
+		fits = fits && bytes >= n ;
+		tight = tight && (n <= SurfacePool::MinBytes || bytes * 4 < n * 5 + 4) ;
+		monotonic = monotonic && index >= last_index && (index != last_index || bytes == last_bytes) ;
+		last_index = index ;
+		last_bytes = bytes ;
+	}
+	Check(fits, "class : capacity never smaller than the request") ;
+	Check(tight, "class : at most 25 % over the request") ;
+	Check(monotonic, "class : one capacity per index, index grows with size") ;
+}
+
+static void CheckReuse() {
+	SurfacePool pool ;
+
+	size_t a_bytes = 5000 ;
+	void* a = pool.Acquire(a_bytes) ;
+	Check(a && a_bytes == 5120, "reuse : capacity written back") ;
+	Check(reinterpret_cast<uintptr_t>(a) % SurfacePool::Alignment == 0, "reuse : block aligned") ;
+	pool.Release(a, a_bytes) ;
+
+	// request lain di class yang sama mendapat block yang sama tanpa heap
+	size_t b_bytes = 4500 ;
+	void* b = pool.Acquire(b_bytes) ;
+	SurfacePool::Stats stats = pool.GetStats() ;
+	Check(b == a && b_bytes == 5120, "reuse : same class returns the cached block") ;
+	Check(stats.heap_allocations_ == 1 && stats.reuses_ == 1, "reuse : counted as reuse, not allocation") ;
+
+	// class lain tidak memakai block itu
+	size_t c_bytes = 9000 ;
+	void* c = pool.Acquire(c_bytes) ;
+	Check(c && c != b && c_bytes == 10240, "reuse : other class allocates") ;
+	Check(pool.GetStats().heap_allocations_ == 2, "reuse : other class counted as allocation") ;
+
+	pool.Release(b, b_bytes) ;
+	pool.Release(c, c_bytes) ;
+}
+
+static void CheckCounters() {
+	SurfacePool pool ;
+
+	size_t a_bytes = 4096 ;
+	size_t b_bytes = 8192 ;
+	void* a = pool.Acquire(a_bytes) ;
+	void* b = pool.Acquire(b_bytes) ;
+	Check(pool.GetLiveBytes() == 12288 && pool.GetPeakBytes() == 12288 && pool.GetCachedBytes() == 0, "counters : live and peak after acquire") ;
+
+	pool.Release(a, a_bytes) ;
+	Check(pool.GetLiveBytes() == 8192 && pool.GetPeakBytes() == 12288 && pool.GetCachedBytes() == 4096, "counters : release moves bytes to cached, peak kept") ;
+
+	pool.ResetPeak() ;
+	Check(pool.GetPeakBytes() == 8192, "counters : ResetPeak drops to live") ;
+
+	a = pool.Acquire(a_bytes) ;
+	Check(pool.GetLiveBytes() == 12288 && pool.GetPeakBytes() == 12288 && pool.GetCachedBytes() == 0, "counters : reuse moves bytes back to live") ;
+
+	pool.Release(a, a_bytes) ;
+	pool.Release(b, b_bytes) ;
+	Check(pool.GetLiveBytes() == 0 && pool.GetCachedBytes() == 12288, "counters : everything cached after release") ;
+
+	pool.Trim() ;
+	Check(pool.GetCachedBytes() == 0 && pool.GetPeakBytes() == 12288, "counters : Trim empties the cache") ;
+
+	size_t d_bytes = 4096 ;
+	void* d = pool.Acquire(d_bytes) ;
+	Check(d && pool.GetStats().heap_allocations_ == 3, "counters : acquire after Trim goes to the heap") ;
+	pool.Release(d, d_bytes) ;
+}
+
+static void CheckPixelBuffer() {
+	SurfacePool& pool = SurfacePool::Global() ;
+	SurfacePool::Stats before = pool.GetStats() ;
+
+	{
+		PixelBuffer pixels ;
+		Check(pixels.Create({100, 100}), "pixels : created") ;
+		size_t capacity = pixels.GetCapacity() ;
+		Check(pool.GetLiveBytes() == before.live_bytes_ + capacity, "pixels : block counted as live") ;
+
+		// ukuran lain di class yang sama : block tetap, tidak ada acquire baru
+		const void* data = pixels.GetData() ;
+		Check(pixels.Create({100, 96}) && pixels.GetData() == data && pixels.GetCapacity() == capacity, "pixels : same class keeps the block") ;
+		Check(pool.GetStats().heap_allocations_ + pool.GetStats().reuses_ == before.heap_allocations_ + before.reuses_ + 1, "pixels : one acquire in total") ;
+	}
+	Check(pool.GetLiveBytes() == before.live_bytes_, "pixels : block returned on destruction") ;
+
+	// buffer berikutnya dengan class yang sama memakai block yang baru dilepas
+	PixelBuffer again ;
+	uint64_t reuses = pool.GetStats().reuses_ ;
+	Check(again.Create({100, 100}) && pool.GetStats().reuses_ == reuses + 1, "pixels : next buffer reuses the block") ;
+}
+
+int main() {
+	CheckClasses() ;
+	CheckReuse() ;
+	CheckCounters() ;
+	CheckPixelBuffer() ;
+
+	if (failed) {
+		logger::error(failed, " check(s) failed") ;
+		return 1 ;
+	}
+
+	logger::info("surface pool checks passed") ;
+	return 0 ;
+}
\ No newline at end of file
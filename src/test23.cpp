@@ -0,0 +1,153 @@
+// pemeriksaan headless untuk SkylinePacker dan TextureAtlas : rect tidak saling tumpang
+// tindih dan berada di dalam halaman, slot yang dilepas dipakai ulang dalam keadaan
+// bersih, halaman di-reset saat live count-nya 0, dan canvas atlas melepas slotnya.
+// return 0 bila semua lolos.
+#include "renderer.hpp"
+
+using namespace zketch ;
+
+static int failed = 0 ;
+
+static void Check(bool ok, const char* what) {
+	if (!ok) {
+		logger::error("FAIL - ", what) ;
+		++failed ;
+	}
+}
+
+static bool Overlaps(const Rect& a, const Rect& b) {
+	return a.x < b.x + static_cast<int32_t>(b.w) && b.x < a.x + static_cast<int32_t>(a.w) &&
+		a.y < b.y + static_cast<int32_t>(b.h) && b.y < a.y + static_cast<int32_t>(a.h) ;
+}
+
+static bool Inside(const Rect& r, uint32_t w, uint32_t h) {
+	return r.x >= 0 && r.y >= 0 && static_cast<uint32_t>(r.x) + r.w <= w && static_cast<uint32_t>(r.y) + r.h <= h ;
+}
+
+static bool Disjoint(const std::vector<Rect>& rects) {
+	for (size_t i = 0; i < rects.size(); ++i) {
+		for (size_t j = i + 1; j < rects.size(); ++j) {
+			if (Overlaps(rects[i], rects[j])) {
+				return false ;
+			}
+		}
+	}
+	return true ;
+}
+
+static void CheckPacker() {
+	SkylinePacker packer(256, 256) ;
+	Rect r ;
+
+	Check(packer.Insert(40, 20, r) && r.x == 0 && r.y == 0, "packer : first rect at the origin") ;
+	Check(packer.Insert(30, 20, r) && r.x == 40 && r.y == 0, "packer : same height goes to the right") ;
+	Check(!packer.Insert(257, 1, r) && !packer.Insert(1, 257, r) && !packer.Insert(0, 4, r), "packer : oversized or empty rejected") ;
+
+	// ukuran campuran sampai penuh
+	packer.Reset() ;
+	std::vector<Rect> placed ;
+	uint64_t area = 0 ;
+	uint32_t seed = 7 ;
+	for (int i = 0; i < 400; ++i) {
+		seed = seed * 1103515245u + 12345u ;
+		uint32_t w = 4 + (seed >> 8) % 45 ;
+		uint32_t h = 4 + (seed >> 16) % 29 ;
+		if (packer.Insert(w, h, r)) {
+			placed.push_back(r) ;
+			area += static_cast<uint64_t>(w) * h ;
+		}
+	}
+
+	bool inside = true ;
+	for (const Rect& p : placed) {
+		inside = inside && Inside(p, 256, 256) ;
+	}
+	Check(placed.size() > 50, "packer : mixed sizes placed") ;
+	Check(inside, "packer : every rect inside the page") ;
+	Check(Disjoint(placed), "packer : no two rects overlap") ;
+	Check(packer.GetUsedArea() == area && packer.GetOccupancy() > 0.5f, "packer : used area matches the placed rects") ;
+
+	packer.Reset() ;
+	Check(packer.GetUsedArea() == 0 && packer.GetNodeCount() == 1, "packer : Reset empties the skyline") ;
+	Check(packer.Insert(256, 256, r) && r.x == 0 && r.y == 0, "packer : full page fits after Reset") ;
+}
+
+static void CheckAtlas() {
+	TextureAtlas atlas({128, 128}) ;
+
+	std::vector<AtlasSlot> slots ;
+	for (int i = 0; i < 12; ++i) {
+		slots.push_back(atlas.Allocate({30, 20})) ;
+	}
+
+	std::vector<Rect> page0 ;
+	bool valid = true ;
+	for (const AtlasSlot& s : slots) {
+		valid = valid && s.IsValid() && Inside(s.rect_, 128, 128) ;
+		if (s.page_ == 0) {
+			page0.push_back(s.rect_) ;
+		}
+	}
+	Check(valid, "atlas : slots valid and inside the page") ;
+	Check(Disjoint(page0), "atlas : slots on a page do not overlap") ;
+	Check(atlas.GetPageCount() == 1 && atlas.GetLiveCount() == 12, "atlas : one page, twelve live slots") ;
+
+	// slot yang dilepas dipakai ulang untuk ukuran yang sama, pixel lama dibersihkan
+	std::fill_n(atlas.GetData(slots[3]), 30, 0xFFFFFFFFu) ;
+	AtlasSlot released = slots[3] ;
+	atlas.Release(slots[3]) ;
+	slots[3] = atlas.Allocate({30, 20}) ;
+	const uint32_t* row = atlas.GetData(slots[3]) ;
+	Check(slots[3].page_ == released.page_ && slots[3].rect_ == released.rect_, "atlas : released slot reused") ;
+	Check(std::all_of(row, row + 30, [](uint32_t px) { return px == 0 ; }), "atlas : reused slot cleared") ;
+
+	// tidak muat lagi : halaman baru
+	AtlasSlot big = atlas.Allocate({128, 100}) ;
+	Check(big.IsValid() && big.page_ == 1 && atlas.GetPageCount() == 2, "atlas : full page opens a new one") ;
+	Check(!atlas.Allocate({129, 1}).IsValid(), "atlas : larger than a page rejected") ;
+
+	// live count halaman 0 menjadi 0 : packer di-reset, free list halaman itu dibuang
+	for (const AtlasSlot& s : slots) {
+		atlas.Release(s) ;
+	}
+	Check(atlas.GetLiveCount() == 1 && atlas.GetOccupancy(0) == 0.0f, "atlas : empty page reset") ;
+
+	AtlasSlot whole = atlas.Allocate({128, 128}) ;
+	Check(whole.IsValid() && whole.page_ == 0 && atlas.GetPageCount() == 2, "atlas : reset page takes a full-size slot") ;
+
+	atlas.Release(whole) ;
+	AtlasSlot small = atlas.Allocate({30, 20}) ;
+	Check(small.page_ == 0 && small.rect_.x == 0 && small.rect_.y == 0, "atlas : no stale free slot after reset") ;
+	atlas.Release(small) ;
+	atlas.Release(big) ;
+	Check(atlas.GetLiveCount() == 0, "atlas : every slot released") ;
+}
+
+static void CheckCanvas() {
+	TextureAtlas atlas({256, 256}) ;
+	{
+		Canvas a ;
+		Canvas b ;
+		Check(a.Create({64, 32}, atlas) && b.Create({64, 32}, atlas), "canvas : created in the atlas") ;
+		Check(a.GetAtlasSlot().IsValid() && b.GetAtlasSlot().IsValid() && !Overlaps(a.GetAtlasSlot().rect_, b.GetAtlasSlot().rect_), "canvas : separate slots") ;
+		Check(atlas.GetLiveCount() == 2, "canvas : slots counted live") ;
+
+		Canvas large ;
+		Check(large.Create({300, 20}, atlas) && !large.GetAtlasSlot().IsValid(), "canvas : too large falls back to its own pixels") ;
+	}
+	Check(atlas.GetLiveCount() == 0 && atlas.GetOccupancy(0) == 0.0f, "canvas : destruction releases and resets the page") ;
+}
+
+int main() {
+	CheckPacker() ;
+	CheckAtlas() ;
+	CheckCanvas() ;
+
+	if (failed) {
+		logger::error(failed, " check(s) failed") ;
+		return 1 ;
+	}
+
+	logger::info("atlas checks passed") ;
+	return 0 ;
+}
\ No newline at end of file
@@ -30,63 +30,72 @@ int main() {
 		logger::info("textinput Submited!") ;
 	}) ;
     
-	Event e ;
     InputSystem input ;
-    
-    while (Application::IsRunning()) {
-        while (PollEvent(e)) {
-            if (e == EventType::Close) {
-                window.Close() ;
-            }
-            
-            if (e.IsMouseEvent()) {
-                button.OnHover(e.GetMousePosition()) ;
-                slider.OnHover(e.GetMousePosition()) ;
-				textinput.OnHover(e.GetMousePosition()) ;
-                
-                if (e.GetMouseState() == MouseState::Down) {
-                    button.OnPress(e.GetMousePosition()) ;
-                    slider.OnPress(e.GetMousePosition()) ;
-					textinput.OnPress(e.GetMousePosition()) ;
-					if (textinput.OnRelease(e.GetMousePosition()) && textinput.IsActive()) {
-						textinput.Deactivate() ;
-					}
-                }
-                
-                if (e.GetMouseState() == MouseState::Up) {
-                    button.OnRelease(e.GetMousePosition()) ;
-                    slider.OnRelease() ;
-                }
-                
-                slider.OnDrag(e.GetMousePosition()) ;
-            }
-
-			if (e == EventType::Key) {
-				if (e.GetKeyState() == KeyState::Down) {
-					if (textinput.IsActive()) {
-						if ((e.GetKeyCode() >= '0' && e.GetKeyCode() <= 'Z') || e.GetKeyCode() == ' ') {
-							textinput.Insert(static_cast<wchar_t>(e.GetKeyCode())) ;
-						} else if (e.GetKeyCode() == static_cast<uint32_t>(KeyCode::ArrowLeft)) {
-							textinput.MoveCursorPrev() ;
-						} else if (e.GetKeyCode() == static_cast<uint32_t>(KeyCode::ArrowRight)) {
-							textinput.MoveCursorNext() ;
-						} else if (e.GetKeyCode() == static_cast<uint32_t>(KeyCode::Enter)) {
-							textinput.Submit() ;
-						} else if (e.GetKeyCode() == static_cast<uint32_t>(KeyCode::Backspace)) {
-							textinput.Backspace() ;
-						}
+
+	// event diproses di luar frame, frame hanya jalan bila ada widget yang dirty
+	Application::SetInputHandler([&](const Event& e) {
+		if (e == EventType::Close) {
+			window.Close() ;
+		}
+
+		if (e.IsMouseEvent()) {
+			button.OnHover(e.GetMousePosition()) ;
+			slider.OnHover(e.GetMousePosition()) ;
+			textinput.OnHover(e.GetMousePosition()) ;
+
+			if (e.GetMouseState() == MouseState::Down) {
+				button.OnPress(e.GetMousePosition()) ;
+				slider.OnPress(e.GetMousePosition()) ;
+				textinput.OnPress(e.GetMousePosition()) ;
+				if (textinput.OnRelease(e.GetMousePosition()) && textinput.IsActive()) {
+					textinput.Deactivate() ;
+				}
+			}
+
+			if (e.GetMouseState() == MouseState::Up) {
+				button.OnRelease(e.GetMousePosition()) ;
+				slider.OnRelease() ;
+			}
+
+			slider.OnDrag(e.GetMousePosition()) ;
+		}
+
+		if (e == EventType::Key) {
+			if (e.GetKeyState() == KeyState::Down) {
+				if (textinput.IsActive()) {
+					if ((e.GetKeyCode() >= '0' && e.GetKeyCode() <= 'Z') || e.GetKeyCode() == ' ') {
+						textinput.Insert(static_cast<wchar_t>(e.GetKeyCode())) ;
+					} else if (e.GetKeyCode() == static_cast<uint32_t>(KeyCode::ArrowLeft)) {
+						textinput.MoveCursorPrev() ;
+					} else if (e.GetKeyCode() == static_cast<uint32_t>(KeyCode::ArrowRight)) {
+						textinput.MoveCursorNext() ;
+					} else if (e.GetKeyCode() == static_cast<uint32_t>(KeyCode::Enter)) {
+						textinput.Submit() ;
+					} else if (e.GetKeyCode() == static_cast<uint32_t>(KeyCode::Backspace)) {
+						textinput.Backspace() ;
 					}
 				}
 			}
-        }
-        
+		}
+	}) ;
+
+	Application::SetDirtyCheck([&] {
+		return button.IsUpdate() || slider.IsUpdate() || textbox.IsUpdate() || textinput.IsUpdate() ;
+	}) ;
+
+	Application::Run([&](const FrameInfo&) {
+		// caret berkedip : bangun lagi walau tidak ada input
 		textinput.UpdateCursor() ;
+		if (textinput.IsActive()) {
+			EventSystem::ScheduleWake(std::chrono::steady_clock::now() + std::chrono::milliseconds(100)) ;
+		}
+
 		button.InvokeUpdate() ;
 		slider.InvokeUpdate() ;
 		textbox.InvokeUpdate() ;
 		textinput.InvokeUpdate() ;
 
-        if (render.Begin(window)) {
+		if (render.Begin(window)) {
 			render.Clear(White) ;
 			render.DrawCanvas(button.GetCanvas(), button.GetPosition()) ;
 			render.DrawCanvas(slider.GetCanvas(), slider.GetPosition()) ;
@@ -96,9 +105,8 @@ int main() {
 		}
 
 		window.Present() ;
-        input.Update() ;
-		Sleep(16) ;
-    }
+		input.Update() ;
+	}) ;
     
     return 0;
 }
\ No newline at end of file